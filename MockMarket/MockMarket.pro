@@ -0,0 +1,24 @@
+#-------------------------------------------------
+#
+# Mock of the Steam login and market servers.
+# Serves recorded fixtures to test SteamKalix offline.
+#
+#-------------------------------------------------
+
+QT       += core network
+QT       -= gui
+
+TARGET = MockMarket
+TEMPLATE = app
+
+CONFIG   += console
+CONFIG   -= app_bundle
+
+INCLUDEPATH += ../SteamKalix
+
+SOURCES += main.cpp \
+        mockmarket.cpp
+
+HEADERS  += mockmarket.h
+
+RESOURCES += fixtures.qrc
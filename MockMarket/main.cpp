@@ -0,0 +1,91 @@
+/*
+ * SteamKalix
+ * Copyright (C) 2014 Filipe Carvalho
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QTextStream>
+#include <QDateTime>
+
+#include "mockmarket.h"
+
+/**
+ * @brief main
+ *      Mock server entry point.
+ *      Start SteamKalix with STEAMKALIX_ENDPOINT=http://127.0.0.1:<port> and the --testing flag to send all the Steam requests to this server.
+ * @param argc
+ *      Command line argument count.
+ * @param argv
+ *      Command line argument vector.
+ * @return
+ *      0 = Success
+ *      1 = The port could not be used
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+int main(int argc, char *argv[])
+{
+    QCoreApplication application(argc, argv);
+    QCoreApplication::setApplicationName("MockMarket");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Mock of the Steam login and market servers.");
+    parser.addHelpOption();
+    parser.addOption(QCommandLineOption("port", "Port to listen on, localhost only.", "port", "8080"));
+    parser.addOption(QCommandLineOption("latency", "Delay of each response (ms).", "ms", "0"));
+    parser.addOption(QCommandLineOption("jitter", "Random delay added to the latency (ms).", "ms", "0"));
+    parser.addOption(QCommandLineOption("error-rate", "Percentage of 503 responses.", "percent", "0"));
+    parser.addOption(QCommandLineOption("drop-rate", "Percentage of connections closed without response.", "percent", "0"));
+    parser.addOption(QCommandLineOption("listings", "Listings per market page, if the request has no count.", "number", "10"));
+    parser.addOption(QCommandLineOption("fixtures", "Directory with fixtures that replace the recorded ones.", "path"));
+    parser.addOption(QCommandLineOption("seed", "Seed of the error and jitter generator.", "seed"));
+    parser.addOption(QCommandLineOption("report", "Prints the counters every N seconds, 0 disables.", "seconds", "0"));
+    parser.addOption(QCommandLineOption("verbose", "Prints each request."));
+    parser.process(application);
+
+    QVariantHash options;
+    options.insert("latency", parser.value("latency").toInt());
+    options.insert("jitter", parser.value("jitter").toInt());
+    options.insert("error_rate", parser.value("error-rate").toInt());
+    options.insert("drop_rate", parser.value("drop-rate").toInt());
+    options.insert("listings", parser.value("listings").toInt());
+    options.insert("fixtures", parser.value("fixtures"));
+    options.insert("verbose", parser.isSet("verbose"));
+
+    qsrand(parser.isSet("seed") ? parser.value("seed").toUInt() : static_cast<uint>(QDateTime::currentMSecsSinceEpoch()));
+
+    MockMarket server(options);
+    QTextStream out(stdout);
+
+    if(!server.listen(QHostAddress::LocalHost, static_cast<quint16>(parser.value("port").toUInt())))
+    {
+        out << "Could not listen: " << server.errorString() << endl;
+        return 1;
+    }
+
+    out << "MockMarket listening on http://127.0.0.1:" << server.serverPort() << endl;
+
+    QTimer report;
+    if(parser.value("report").toInt() > 0)
+    {
+        QObject::connect(&report, SIGNAL(timeout()), &server, SLOT(report()));
+        report.start(parser.value("report").toInt() * 1000);
+    }
+
+    return application.exec();
+}
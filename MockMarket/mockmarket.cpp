@@ -0,0 +1,467 @@
+/*
+ * SteamKalix
+ * Copyright (C) 2014 Filipe Carvalho
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "mockmarket.h"
+
+#include <QCryptographicHash>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QDateTime>
+#include <QFile>
+
+/**
+ * @brief MockMarket::MockMarket
+ *      Initializes the options, see the class remarks.
+ * @param options
+ *      The options of the server, missing options use the defaults.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+MockMarket::MockMarket(const QVariantHash &options, QObject *parent) :
+    QTcpServer(parent),
+    latency(options.value("latency", 0).toInt()),
+    jitter(options.value("jitter", 0).toInt()),
+    error_rate(options.value("error_rate", 0).toInt()),
+    drop_rate(options.value("drop_rate", 0).toInt()),
+    listings_size(options.value("listings", 10).toInt()),
+    fixtures_path(options.value("fixtures", "").toString()),
+    verbose(options.value("verbose", false).toBool()),
+    requests(0),
+    errors(0),
+    drops(0),
+    not_modified(0),
+    bytes_body(0),
+    bytes_sent(0)
+{
+    connect(this, SIGNAL(newConnection()), this, SLOT(socket_connected()));
+}
+
+/**
+ * @brief MockMarket::socket_connected
+ *      This slot is received from the newConnection() signal of the server.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void MockMarket::socket_connected()
+{
+    while(hasPendingConnections())
+    {
+        QTcpSocket *socket = nextPendingConnection();
+        buffers.insert(socket, QByteArray());
+
+        connect(socket, SIGNAL(readyRead()), this, SLOT(socket_ready()));
+        connect(socket, SIGNAL(disconnected()), this, SLOT(socket_disconnected()));
+    }
+}
+
+/**
+ * @brief MockMarket::socket_ready
+ *      This slot is received from the readyRead() signal of a connection.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void MockMarket::socket_ready()
+{
+    QTcpSocket *socket = qobject_cast<QTcpSocket*>(sender());
+
+    if(socket != NULL)
+    {
+        buffers[socket].append(socket->readAll());
+        process_request(socket);
+    }
+}
+
+/**
+ * @brief MockMarket::socket_disconnected
+ *      This slot is received from the disconnected() signal of a connection.
+ *      Pending responses of the connection are discarded when they are due (QPointer).
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void MockMarket::socket_disconnected()
+{
+    QTcpSocket *socket = qobject_cast<QTcpSocket*>(sender());
+
+    if(socket != NULL)
+    {
+        buffers.remove(socket);
+        socket->deleteLater();
+    }
+}
+
+/**
+ * @brief MockMarket::process_request
+ *      Parses the next complete request of a connection and schedules the response.
+ *      A connection has one request in process at a time, so responses are never reordered by the jitter.
+ * @param socket
+ *      The connection.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void MockMarket::process_request(QTcpSocket *socket)
+{
+    QByteArray &buffer = buffers[socket];
+    int header_end = buffer.indexOf("\r\n\r\n");
+
+    if(socket->property("busy").toBool() || header_end == -1)
+    {
+        return;
+    }
+
+    //Request line and headers
+    QList<QByteArray> lines = buffer.left(header_end).split('\n');
+    QList<QByteArray> request_line = lines.at(0).trimmed().split(' ');
+    QHash<QByteArray, QByteArray> headers;
+
+    for(int i = 1; i < lines.size(); i++)
+    {
+        int separator = lines.at(i).indexOf(':');
+
+        if(separator > 0)
+        {
+            headers.insert(lines.at(i).left(separator).trimmed().toLower(), lines.at(i).mid(separator + 1).trimmed());
+        }
+    }
+
+    //Wait for the whole body, it is not used
+    int content_length = headers.value("content-length", "0").toInt();
+
+    if(buffer.size() < header_end + 4 + content_length)
+    {
+        return;
+    }
+
+    buffer.remove(0, header_end + 4 + content_length);
+
+    QByteArray method = request_line.value(0);
+    QUrl url(QString::fromLatin1(request_line.value(1)));
+    requests++;
+
+    if(verbose)
+    {
+        qDebug("%s %s", method.constData(), request_line.value(1).constData());
+    }
+
+    //Build the response, or fail on purpose
+    Response delayed_response;
+    delayed_response.socket = socket;
+    delayed_response.drop = false;
+    delayed_response.close = headers.value("connection").toLower() == "close";
+
+    if(qrand() % 100 < drop_rate)
+    {
+        delayed_response.drop = true;
+        drops++;
+    }
+    else if(qrand() % 100 < error_rate)
+    {
+        delayed_response.data = response(503, "text/html", "<html><body>Service Unavailable</body></html>", "Retry-After: 1\r\n");
+        errors++;
+    }
+    else
+    {
+        delayed_response.data = route(method, url, headers);
+    }
+
+    QTimer *timer = new QTimer(this);
+    timer->setSingleShot(true);
+    connect(timer, SIGNAL(timeout()), this, SLOT(send_delayed()));
+
+    delayed.insert(timer, delayed_response);
+    socket->setProperty("busy", true);
+    timer->start(latency + (jitter > 0 ? qrand() % (jitter + 1) : 0));
+}
+
+/**
+ * @brief MockMarket::send_delayed
+ *      This slot is received from the timeout() signal of the latency timer.
+ *      Writes (or drops) the response and continues with the next request of the connection.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void MockMarket::send_delayed()
+{
+    QTimer *timer = qobject_cast<QTimer*>(sender());
+    Response delayed_response = delayed.take(timer);
+    timer->deleteLater();
+
+    QTcpSocket *socket = delayed_response.socket.data();
+
+    if(socket == NULL)
+    {
+        return;
+    }
+
+    if(delayed_response.drop)
+    {
+        socket->abort();
+        return;
+    }
+
+    socket->write(delayed_response.data);
+    socket->setProperty("busy", false);
+
+    if(delayed_response.close)
+    {
+        socket->disconnectFromHost();
+    }
+    else
+    {
+        process_request(socket);
+    }
+}
+
+/**
+ * @brief MockMarket::route
+ *      Builds the response of a request from the fixtures.
+ *      The body is compressed (deflate) when the request accepts it.
+ * @param method
+ *      GET or POST.
+ * @param url
+ *      Path and query of the request.
+ * @param headers
+ *      Headers of the request, with lower case names.
+ * @return
+ *      The complete response.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+QByteArray MockMarket::route(const QByteArray &method, const QUrl &url, const QHash<QByteArray, QByteArray> &headers)
+{
+    QString path = url.path();
+    QByteArray content_type = "text/html; charset=utf-8";
+    QByteArray cookies;
+    QByteArray body;
+
+    if(path.startsWith("/login/getrsakey"))
+    {
+        content_type = "application/json; charset=utf-8";
+        body = fixture("getrsakey.json");
+    }
+    else if(path.startsWith("/login/dologin"))
+    {
+        content_type = "application/json; charset=utf-8";
+        body = fixture("dologin.json");
+        cookies = "Set-Cookie: steamLogin=76561198000000000%7C%7CMOCK; path=/\r\n";
+    }
+    else if(path.startsWith("/login/transfer"))
+    {
+        body = fixture("transfer.html");
+        cookies = "Set-Cookie: steamLogin=76561198000000000%7C%7CMOCK; path=/\r\n"
+                  "Set-Cookie: steamLoginSecure=76561198000000000%7C%7CMOCKSECURE; path=/\r\n"
+                  "Set-Cookie: steamRememberLogin=76561198000000000%7C%7CMOCKREMEMBER; "
+                  "Expires=" + QDateTime::currentDateTimeUtc().addDays(30).toString("ddd, dd MMM yyyy hh:mm:ss 'GMT'").toLatin1() +
+                  "; path=/\r\n";
+    }
+    else if(path.startsWith("/account"))
+    {
+        body = fixture("account.html");
+    }
+    else if(path.startsWith("/market/eligibilitycheck"))
+    {
+        body = fixture("store.html");
+        cookies = "Set-Cookie: webTradeEligibility=%7B%22allowed%22%3A1%7D; path=/market\r\n";
+    }
+    else if((path.startsWith("/profiles/") || path.startsWith("/id/")) && QUrlQuery(url).hasQueryItem("xml"))
+    {
+        content_type = "text/xml; charset=utf-8";
+        body = fixture("profile.xml");
+    }
+    else if(path.startsWith("/market/listings/") && path.endsWith("/render/"))
+    {
+        content_type = "application/json; charset=utf-8";
+        body = listings(QUrlQuery(url));
+    }
+    else if(method == "GET")
+    {
+        body = fixture("store.html");
+    }
+    else
+    {
+        return response(404, content_type, "<html><body>Not Found</body></html>");
+    }
+
+    QByteArray etag = "\"" + QCryptographicHash::hash(body, QCryptographicHash::Md5).toHex().left(16) + "\"";
+
+    if(method == "GET" && headers.value("if-none-match") == etag)
+    {
+        not_modified++;
+        return response(304, content_type, QByteArray(), "ETag: " + etag + "\r\n");
+    }
+
+    bytes_body += body.size();
+
+    //Compressed like the real servers, qCompress is zlib with a 4 byte size in front
+    if(headers.value("accept-encoding").contains("deflate"))
+    {
+        body = qCompress(body).mid(4);
+        cookies.append("Content-Encoding: deflate\r\n");
+    }
+
+    bytes_sent += body.size();
+
+    return response(200, content_type, body, cookies + "ETag: " + etag + "\r\n");
+}
+
+/**
+ * @brief MockMarket::response
+ *      Builds a complete HTTP/1.1 response.
+ * @param status
+ *      The status code.
+ * @param content_type
+ *      Type of the body.
+ * @param body
+ *      The body.
+ * @param extra_headers
+ *      Other headers, each one terminated by CRLF.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+QByteArray MockMarket::response(const int &status, const QByteArray &content_type, const QByteArray &body, const QByteArray &extra_headers) const
+{
+    QByteArray reason;
+
+    switch(status)
+    {
+    case 200: reason = "OK"; break;
+    case 304: reason = "Not Modified"; break;
+    case 404: reason = "Not Found"; break;
+    case 503: reason = "Service Unavailable"; break;
+    default: reason = "Unknown";
+    }
+
+    QByteArray data;
+    data.append("HTTP/1.1 " + QByteArray::number(status) + " " + reason + "\r\n");
+    data.append("Server: MockMarket\r\n");
+    data.append("Content-Type: " + content_type + "\r\n");
+    data.append("Content-Length: " + QByteArray::number(body.size()) + "\r\n");
+    data.append("Cache-Control: no-cache\r\n");
+    data.append(extra_headers);
+    data.append("\r\n");
+    data.append(body);
+
+    return data;
+}
+
+/**
+ * @brief MockMarket::fixture
+ *      Reads a fixture, from the fixtures directory if it has the file, otherwise the recorded one.
+ *      Fixtures are read once.
+ * @param name
+ *      File name of the fixture.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+QByteArray MockMarket::fixture(const QString &name)
+{
+    if(!fixtures.contains(name))
+    {
+        QFile file(fixtures_path + "/" + name);
+
+        if(fixtures_path.isEmpty() || !file.exists())
+        {
+            file.setFileName(":/fixtures/" + name);
+        }
+
+        file.open(QIODevice::ReadOnly);
+        fixtures.insert(name, file.readAll());
+    }
+
+    return fixtures.value(name);
+}
+
+/**
+ * @brief MockMarket::listings
+ *      Builds a market page, the first listing of the fixture is repeated to the requested size.
+ *      Prices change slowly over time, so consecutive polls are mostly unchanged (304).
+ * @param query
+ *      Parameters of the request, "start" and "count" are used.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+QByteArray MockMarket::listings(const QUrlQuery &query)
+{
+    QJsonObject page = QJsonDocument::fromJson(fixture("listings.json")).object();
+    QJsonObject listinginfo = page.value("listinginfo").toObject();
+    QJsonObject listing = listinginfo.value(listinginfo.keys().value(0)).toObject();
+
+    int start = query.queryItemValue("start").toInt();
+    int count = query.hasQueryItem("count") ? query.queryItemValue("count").toInt() : listings_size;
+    int epoch = static_cast<int>(QDateTime::currentMSecsSinceEpoch() / 10000);
+
+    QJsonObject new_listinginfo;
+    for(int i = 0; i < count; i++)
+    {
+        QString id = QString::number(1000000000000000000LL + start + i);
+        int price = listing.value("price").toInt() + i + (epoch % 7);
+
+        listing.insert("listingid", id);
+        listing.insert("price", price);
+        listing.insert("converted_price", price);
+        new_listinginfo.insert(id, listing);
+    }
+
+    page.insert("start", start);
+    page.insert("pagesize", count);
+    page.insert("total_count", start + count);
+    page.insert("listinginfo", new_listinginfo);
+
+    return QJsonDocument(page).toJson(QJsonDocument::Compact);
+}
+
+/**
+ * @brief MockMarket::print
+ *      Creates a string with the counters of the server.
+ * @return
+ *      Data to be displayed
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+QString MockMarket::print() const
+{
+    return "Requests: " + QString::number(requests) +
+           " - Errors: " + QString::number(errors) +
+           " - Drops: " + QString::number(drops) +
+           " - Not modified: " + QString::number(not_modified) +
+           " - Body: " + QString::number(bytes_body / 1024) + " KB" +
+           " - Sent: " + QString::number(bytes_sent / 1024) + " KB";
+}
+
+/**
+ * @brief MockMarket::report
+ *      Prints the counters of the server to the standard output.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void MockMarket::report() const
+{
+    QTextStream out(stdout);
+    out << print() << endl;
+}
@@ -0,0 +1,115 @@
+/*
+ * SteamKalix
+ * Copyright (C) 2014 Filipe Carvalho
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MOCKMARKET_H
+#define MOCKMARKET_H
+
+#include <QObject>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTextStream>
+#include <QVariantHash>
+#include <QUrlQuery>
+#include <QPointer>
+#include <QTimer>
+#include <QHash>
+#include <QUrl>
+
+#include "defines.h"
+
+/**
+ * @brief The MockMarket class
+ *      Minimal HTTP/1.1 server that mocks the Steam endpoints used by SteamKalix, from recorded fixtures.
+ *      Login:    /login/getrsakey/, /login/dologin/, /login/transfer, /account/, /market/eligibilitycheck/,
+ *                /profiles/<id>/?xml=1 and /id/<id>/?xml=1.
+ *      Market:   /market/listings/<appid>/<name>/render/, the page size follows the "count" parameter.
+ *      Any other GET returns the store page.
+ * @remarks Options
+ *      latency         Delay of each response, in milliseconds.
+ *      jitter          Random delay added to the latency, in milliseconds.
+ *      error_rate      Percentage of requests answered with 503 and Retry-After.
+ *      drop_rate       Percentage of requests where the connection is closed without response.
+ *      listings        Number of listings in each market page, when the request does not set "count".
+ *      fixtures        Directory with fixtures that replace the recorded ones, same file names.
+ *      verbose         Prints each request.
+ * @remarks
+ *      Every 200 has an ETag, a request with the same If-None-Match gets a 304.
+ *      Connections are kept alive, the requests of a connection are answered in order.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+class MockMarket : public QTcpServer
+{
+    Q_OBJECT
+
+public_construct:
+    explicit MockMarket(const QVariantHash &options, QObject *parent = 0);
+
+public_methods:
+    QString print() const;
+
+private_methods:
+    void process_request(QTcpSocket *socket);
+    QByteArray route(const QByteArray &method, const QUrl &url, const QHash<QByteArray, QByteArray> &headers);
+    QByteArray response(const int &status, const QByteArray &content_type, const QByteArray &body,
+                        const QByteArray &extra_headers = QByteArray()) const;
+    QByteArray fixture(const QString &name);
+    QByteArray listings(const QUrlQuery &query);
+
+private_members:
+    int latency;
+    int jitter;
+    int error_rate;
+    int drop_rate;
+    int listings_size;
+    QString fixtures_path;
+    bool verbose;
+
+    int requests;
+    int errors;
+    int drops;
+    int not_modified;
+    qint64 bytes_body;
+    qint64 bytes_sent;
+
+private_data_members:
+    struct Response
+    {
+        QPointer<QTcpSocket> socket;
+        QByteArray data;
+        bool drop;
+        bool close;
+    };
+
+    QHash<QTcpSocket*, QByteArray> buffers;
+    QHash<QTimer*, Response> delayed;
+    QHash<QString, QByteArray> fixtures;
+
+public slots:
+    void report() const;
+
+private slots:
+    void socket_connected();
+    void socket_ready();
+    void socket_disconnected();
+    void send_delayed();
+
+};
+
+#endif // MOCKMARKET_H
@@ -17,25 +17,51 @@ SOURCES += main.cpp\
         persistentcookiejar.cpp \
         settingsmanager.cpp \
         networkmanager.cpp \
-        replytimeout.cpp \
         threadmanager.cpp \
         helper.cpp \
         accountdata.cpp \
         listingsmanager.cpp \
-        output.cpp
+        output.cpp \
+        sessioncache.cpp \
+        networkfuture.cpp \
+        networkbatch.cpp \
+        timerwheel.cpp \
+        latencyhistogram.cpp \
+        responsecache.cpp \
+        jsonstream.cpp \
+        postbody.cpp \
+        requestlimiter.cpp \
+        bufferpool.cpp \
+        dnscache.cpp \
+        streamdecoder.cpp \
+        cookieset.cpp \
+        cookiejournal.cpp
 
 HEADERS  += steamkalix.h \
         login.h \
         persistentcookiejar.h \
         settingsmanager.h \
         networkmanager.h \
-        replytimeout.h \
         threadmanager.h \
         helper.h \
         accountdata.h \
         listingsmanager.h \
         defines.h \
-        output.h
+        output.h \
+        sessioncache.h \
+        networkfuture.h \
+        networkbatch.h \
+        timerwheel.h \
+        latencyhistogram.h \
+        responsecache.h \
+        jsonstream.h \
+        postbody.h \
+        requestlimiter.h \
+        bufferpool.h \
+        dnscache.h \
+        streamdecoder.h \
+        cookieset.h \
+        cookiejournal.h
 
 FORMS += steamkalix.ui
 
@@ -48,6 +74,16 @@ win32:LIBS +=   -LC:/OpenSSL-Win32/lib -llibeay32 \
 
 win32:INCLUDEPATH += C:/OpenSSL-Win32/include
 
+#zlib is bundled with Qt on Windows
+win32:INCLUDEPATH += $$[QT_INSTALL_HEADERS]/QtZlib
+
 #-------------------------- LINUX --------------------------
 
-unix:LIBS += -lcrypto -lssl
+unix:LIBS += -lcrypto -lssl -lz
+
+#-------------------------- BROTLI --------------------------
+
+unix:packagesExist(libbrotlidec) {
+    DEFINES += HAVE_BROTLI
+    LIBS += -lbrotlidec
+}
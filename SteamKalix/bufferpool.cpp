@@ -0,0 +1,207 @@
+/*
+ * SteamKalix
+ * Copyright (C) 2014 Filipe Carvalho
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "bufferpool.h"
+
+/**
+ *@brief Anonymous namespace
+ *      This namespace is used as a "private section".
+ *      It is anonymous and therefore can only accessed within file scope.
+ *@remarks Variables
+ *      At most pool_maximum buffers are kept, buffers larger than buffer_maximum are freed.
+ *      The observed size of a key decays by 1/8 on each release, so a single large page does not keep the pool large.
+ *@date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+namespace
+{
+    const int pool_maximum = 64;
+    const int buffer_maximum = 4 * 1024 * 1024;
+    const int buffer_minimum = 4 * 1024;
+
+    QMutex mutex;
+    QList<QByteArray> buffers;
+    QHash<QString, int> sizes;
+    qint64 pooled_bytes = 0;
+    QAtomicInt hits(0);
+    QAtomicInt misses(0);
+}
+
+/**
+ * @brief BufferPool::acquire
+ *      Gets an empty buffer, with the capacity of the payloads observed for the key.
+ * @param key
+ *      The host and path of the request. Empty uses the minimum size.
+ * @return
+ *      The buffer. A pooled buffer large enough is a hit, otherwise a new one is reserved (miss).
+ * @remarks
+ *      This function should be thread-safe.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+QByteArray BufferPool::acquire(const QString &key)
+{
+    QByteArray buffer;
+
+    mutex.lock();
+    int size = qMax(buffer_minimum, sizes.value(key));
+
+    for(int i = buffers.size() - 1; i >= 0; i--)
+    {
+        if(buffers.at(i).capacity() >= size)
+        {
+            buffer = buffers.takeAt(i);
+            pooled_bytes -= buffer.capacity();
+            break;
+        }
+    }
+
+    if(buffer.capacity() >= size)
+    {
+        hits.ref();
+    }
+    else
+    {
+        misses.ref();
+    }
+    mutex.unlock();
+
+    //Reserve marks the capacity, resize(0) on release keeps it
+    buffer.reserve(size);
+
+    return buffer;
+}
+
+/**
+ * @brief BufferPool::release
+ *      Returns a buffer to the pool and records the size of its payload for the key.
+ * @param buffer
+ *      The buffer, it is empty after this call.
+ * @param key
+ *      The host and path of the request.
+ * @remarks
+ *      This function should be thread-safe.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void BufferPool::release(QByteArray &buffer, const QString &key)
+{
+    mutex.lock();
+    if(!buffer.isEmpty())
+    {
+        int &size = sizes[key];
+        size = qMax(buffer.size(), size - size / 8);
+    }
+
+    if(buffer.isDetached() && buffer.capacity() <= buffer_maximum && buffers.size() < pool_maximum)
+    {
+        buffer.reserve(buffer.capacity());
+        buffer.resize(0);
+        pooled_bytes += buffer.capacity();
+        buffers.append(buffer);
+    }
+    mutex.unlock();
+
+    buffer = QByteArray();
+}
+
+/**
+ * @brief BufferPool::read
+ *      Reads all the available data of a device to the end of the buffer.
+ *      Unlike readAll, no intermediate array is allocated, the data is copied into the reserved capacity.
+ * @param device
+ *      The device, usually a reply.
+ * @param buffer
+ *      The buffer, from acquire.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void BufferPool::read(QIODevice *device, QByteArray &buffer)
+{
+    qint64 available = device->bytesAvailable();
+
+    if(available > 0)
+    {
+        int size = buffer.size();
+        buffer.resize(size + static_cast<int>(available));
+
+        qint64 read = device->read(buffer.data() + size, available);
+        buffer.resize(size + static_cast<int>(qMax(Q_INT64_C(0), read)));
+    }
+}
+
+/**
+ * @brief BufferPool::clear
+ *      Frees all the pooled buffers. The observed sizes and the counters are kept.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void BufferPool::clear()
+{
+    mutex.lock();
+    buffers.clear();
+    pooled_bytes = 0;
+    mutex.unlock();
+}
+
+/**
+ * @brief BufferPool::get_hits
+ * @brief BufferPool::get_misses
+ *      Number of buffers that were reused (hit) or had to be allocated (miss).
+ * @remarks
+ *      The counters are atomic, they are read without the mutex.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+int BufferPool::get_hits()
+{
+    return hits.loadAcquire();
+}
+
+int BufferPool::get_misses()
+{
+    return misses.loadAcquire();
+}
+
+/**
+ * @brief BufferPool::print
+ *      Creates a string with the state of the pool.
+ *      Use and output method that supports HTML.
+ * @return
+ *      Data to be displayed
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+QString BufferPool::print()
+{
+    mutex.lock();
+    QString pool_print = "Buffers: " + QString::number(buffers.size()) +
+                         " (" + QString::number(pooled_bytes / 1024) + " KB)" +
+                         " - Hits: " + QString::number(hits.loadAcquire()) +
+                         " - Misses: " + QString::number(misses.loadAcquire());
+    mutex.unlock();
+
+    return pool_print;
+}
@@ -0,0 +1,54 @@
+/*
+ * SteamKalix
+ * Copyright (C) 2014 Filipe Carvalho
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef BUFFERPOOL_H
+#define BUFFERPOOL_H
+
+#include <QString>
+#include <QByteArray>
+#include <QList>
+#include <QHash>
+#include <QMutex>
+#include <QAtomicInt>
+#include <QIODevice>
+
+/**
+ * @brief The BufferPool namespace
+ *      This namespace keeps the buffers of the replies, so they are reused instead of allocated for every response.
+ *      The size of the payload is observed per key (host and path), a buffer is acquired with that capacity
+ *      already reserved and the body is read into it, without growing it chunk by chunk.
+ * @remarks
+ *      A buffer that is still shared (e.g. a copy of the body is kept) is not returned to the pool.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+namespace BufferPool
+{
+    QByteArray acquire(const QString &key = QString());
+    void release(QByteArray &buffer, const QString &key = QString());
+    void read(QIODevice *device, QByteArray &buffer);
+    void clear();
+
+    int get_hits();
+    int get_misses();
+
+    QString print();
+}
+
+#endif // BUFFERPOOL_H
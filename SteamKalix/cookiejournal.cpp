@@ -0,0 +1,553 @@
+/*
+ * SteamKalix
+ * Copyright (C) 2014 Filipe Carvalho
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "cookiejournal.h"
+
+/**
+ *@brief Anonymous namespace
+ *      This namespace is used as a "private section".
+ *      It is anonymous and therefore can only accessed within file scope.
+ *@remarks Variables
+ *      The file starts with a magic number and a version, followed by the records.
+ *      The journal is compacted when it has more than compact_minimum records and twice as many records as cookies.
+ *      The background saves run on journal_pool, created on first use with a single thread.
+ *      SaveTask keeps a copy of the set (implicitly shared), the list of cookies is built on the background thread.
+ *      journal_blocked is set when an unreadable journal could not be moved aside, so it is never written over.
+ *      journal_rewrite is set when an append failed, the file misses changes that are already in memory.
+ *@date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+namespace
+{
+    class SaveTask : public QRunnable
+    {
+    public:
+        SaveTask(const QString &user, const CookieSet &cookies) : user(user), cookies(cookies) {}
+
+        void run()
+        {
+            CookieJournal::save(user, cookies.all_cookies());
+        }
+
+    private:
+        QString user;
+        CookieSet cookies;
+    };
+
+    const quint32 journal_magic = 0x534B434A;
+    const quint32 journal_version = 1;
+    const int compact_minimum = 256;
+
+    QString journal_filename = "cookies.dat";
+
+    QMutex mutex;
+    QHash<QString, QHash<QByteArray, QNetworkCookie> > users;
+    bool journal_read = false;
+    bool journal_blocked = false;
+    bool journal_rewrite = false;
+    int cookies_count = 0;
+    int records = 0;
+    int compactions = 0;
+    QThreadPool *journal_pool = NULL;
+}
+
+/**
+ * @brief CookieJournal::contains
+ *      Checks if the journal has the cookies of the user.
+ * @param user
+ *      The name of the user.
+ * @return
+ *      True if the cookies of the user were saved, even if there are none left.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+bool CookieJournal::contains(const QString &user)
+{
+    mutex.lock();
+    read_journal();
+    bool result = users.contains(user);
+    mutex.unlock();
+
+    return result;
+}
+
+/**
+ * @brief CookieJournal::load
+ *      Gets the saved cookies of the user, the expired cookies are skipped.
+ * @param user
+ *      The name of the user.
+ * @return
+ *      The list of cookies.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+QList<QNetworkCookie> CookieJournal::load(const QString &user)
+{
+    QList<QNetworkCookie> cookies_list;
+    QDateTime now = QDateTime::currentDateTimeUtc();
+
+    mutex.lock();
+    read_journal();
+
+    const QHash<QByteArray, QNetworkCookie> cookies = users.value(user);
+    for(QHash<QByteArray, QNetworkCookie>::const_iterator i = cookies.constBegin(); i != cookies.constEnd(); ++i)
+    {
+        if(i.value().isSessionCookie() || i.value().expirationDate() > now)
+        {
+            cookies_list.append(i.value());
+        }
+    }
+    mutex.unlock();
+
+    return cookies_list;
+}
+
+/**
+ * @brief CookieJournal::save
+ *      Saves the cookies of the user. Only the differences to the last save are appended to the journal.
+ * @param user
+ *      The name of the user.
+ * @param cookies_list
+ *      All the cookies of the user, the cookies that are not in the list are removed.
+ * @return
+ *      True if the changes were written (or there were none), false if the file could not be written.
+ * @remarks
+ *      The cookies are compared in memory, the file only receives the changes.
+ *      If the changes cannot be appended, the memory is ahead of the file: the whole journal is rewritten
+ *      by this save and, until it succeeds, by the next ones (even without changes).
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+bool CookieJournal::save(const QString &user, const QList<QNetworkCookie> &cookies_list)
+{
+    bool result = true;
+
+    QHash<QByteArray, QNetworkCookie> cookies;
+    for(int i = 0; i < cookies_list.size(); i++)
+    {
+        cookies.insert(cookie_key(cookies_list.at(i)), cookies_list.at(i));
+    }
+
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_0);
+    int changes = 0;
+
+    mutex.lock();
+    read_journal();
+
+    QHash<QByteArray, QNetworkCookie> &saved = users[user];
+
+    for(QHash<QByteArray, QNetworkCookie>::const_iterator i = cookies.constBegin(); i != cookies.constEnd(); ++i)
+    {
+        QHash<QByteArray, QNetworkCookie>::const_iterator saved_cookie = saved.constFind(i.key());
+
+        if(saved_cookie == saved.constEnd() || !(saved_cookie.value() == i.value()))
+        {
+            write_record(stream, Insert, user, i.value());
+            changes++;
+        }
+    }
+
+    for(QHash<QByteArray, QNetworkCookie>::const_iterator i = saved.constBegin(); i != saved.constEnd(); ++i)
+    {
+        if(!cookies.contains(i.key()))
+        {
+            write_record(stream, Remove, user, i.value());
+            changes++;
+        }
+    }
+
+    if(changes > 0)
+    {
+        cookies_count += cookies.size() - saved.size();
+        saved = cookies;
+        records += changes;
+
+        //A failed append leaves the file behind the memory, it is rewritten from the memory
+        if(!journal_rewrite && !append_journal(data))
+        {
+            journal_rewrite = true;
+        }
+    }
+
+    if(journal_rewrite || (changes > 0 && records > compact_minimum && records > 2 * cookies_count))
+    {
+        result = write_journal();
+
+        if(result)
+        {
+            journal_rewrite = false;
+        }
+    }
+    mutex.unlock();
+
+    return result;
+}
+
+/**
+ * @brief CookieJournal::save_later
+ *      Queues a save of the cookies of the user, it is written in the background (see save).
+ * @param user
+ *      The name of the user.
+ * @param cookies
+ *      All the cookies of the user. The set is implicitly shared, it is not copied.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void CookieJournal::save_later(const QString &user, const CookieSet &cookies)
+{
+    mutex.lock();
+    if(journal_pool == NULL)
+    {
+        journal_pool = new QThreadPool();
+        journal_pool->setMaxThreadCount(1);
+    }
+
+    journal_pool->start(new SaveTask(user, cookies));
+    mutex.unlock();
+}
+
+/**
+ * @brief CookieJournal::wait
+ *      Waits until the queued saves are written.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void CookieJournal::wait()
+{
+    mutex.lock();
+    QThreadPool *pool = journal_pool;
+    mutex.unlock();
+
+    if(pool != NULL)
+    {
+        pool->waitForDone();
+    }
+}
+
+/**
+ * @brief CookieJournal::compact
+ *      Rewrites the journal with one record per cookie, the expired cookies are dropped.
+ * @return
+ *      True if the journal was rewritten.
+ * @remarks
+ *      This is done automatically by save, when most of the records are outdated.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+bool CookieJournal::compact()
+{
+    mutex.lock();
+    read_journal();
+    bool result = write_journal();
+    mutex.unlock();
+
+    return result;
+}
+
+/**
+ * @brief CookieJournal::print
+ *      Creates a string with the state of the journal.
+ *      Use and output method that supports HTML.
+ * @return
+ *      Data to be displayed
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+QString CookieJournal::print()
+{
+    mutex.lock();
+    QString journal_print = "Cookie journal: " + QString::number(users.size()) + " users" +
+                            " - Cookies: " + QString::number(cookies_count) +
+                            " - Records: " + QString::number(records) +
+                            " - Compactions: " + QString::number(compactions);
+    mutex.unlock();
+
+    return journal_print;
+}
+
+/**
+ * @brief CookieJournal::read_journal
+ *      Reads the journal on first use and replays the records into memory.
+ *      A record cut short is dropped and the file is truncated to the last complete record.
+ *      A file with an unknown format is never overwritten: it is moved aside (cookies.dat.<date>.bad) and the error is logged,
+ *      the journal then starts empty. If it cannot be moved, the journal is not written until the application restarts.
+ * @remarks
+ *      Must be called holding the mutex.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void CookieJournal::read_journal()
+{
+    if(journal_read)
+    {
+        return;
+    }
+
+    journal_read = true;
+
+    QFile file(SettingsManager::get_filepath() + journal_filename);
+
+    if(!file.open(QIODevice::ReadOnly))
+    {
+        return;
+    }
+
+    QByteArray data = file.readAll();
+    file.close();
+
+    if(data.isEmpty())
+    {
+        //The header is written by the first append
+        return;
+    }
+
+    QDataStream stream(data);
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    stream >> magic >> version;
+
+    if(magic != journal_magic || version != journal_version)
+    {
+        QString unreadable = file.fileName() + "." + QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss") + ".bad";
+
+        if(QFile::rename(file.fileName(), unreadable))
+        {
+            qWarning("Cookie journal: unknown format (magic %08x, version %u), moved to %s.",
+                     magic, version, qPrintable(unreadable));
+        }
+        else
+        {
+            journal_blocked = true;
+            qWarning("Cookie journal: unknown format (magic %08x, version %u), %s could not be moved, the cookies are not saved.",
+                     magic, version, qPrintable(file.fileName()));
+        }
+
+        return;
+    }
+
+    qint64 complete = stream.device()->pos();
+
+    while(!stream.atEnd())
+    {
+        quint8 type = 0;
+        QString user;
+        QByteArray name;
+        QString domain;
+        QString path;
+        stream >> type >> user >> name >> domain >> path;
+
+        QNetworkCookie cookie(name);
+        cookie.setDomain(domain);
+        cookie.setPath(path);
+
+        if(type == Insert)
+        {
+            QByteArray value;
+            qint64 expiration = 0;
+            bool secure = false;
+            bool http_only = false;
+            stream >> value >> expiration >> secure >> http_only;
+
+            cookie.setValue(value);
+            cookie.setSecure(secure);
+            cookie.setHttpOnly(http_only);
+
+            if(expiration >= 0)
+            {
+                cookie.setExpirationDate(QDateTime::fromMSecsSinceEpoch(expiration).toUTC());
+            }
+        }
+
+        if(stream.status() != QDataStream::Ok || (type != Insert && type != Remove))
+        {
+            break;
+        }
+
+        QHash<QByteArray, QNetworkCookie> &cookies = users[user];
+        int size = cookies.size();
+
+        if(type == Insert)
+        {
+            cookies.insert(cookie_key(cookie), cookie);
+        }
+        else
+        {
+            cookies.remove(cookie_key(cookie));
+        }
+
+        cookies_count += cookies.size() - size;
+        records++;
+        complete = stream.device()->pos();
+    }
+
+    if(complete < data.size())
+    {
+        QFile::resize(SettingsManager::get_filepath() + journal_filename, complete);
+    }
+}
+
+/**
+ * @brief CookieJournal::append_journal
+ *      Appends records to the journal, the header is written first if the file is new.
+ * @param data
+ *      The records.
+ * @return
+ *      True if written.
+ * @remarks
+ *      Must be called holding the mutex.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+bool CookieJournal::append_journal(const QByteArray &data)
+{
+    if(journal_blocked)
+    {
+        return false;
+    }
+
+    QFile file(SettingsManager::get_filepath() + journal_filename);
+
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Append))
+    {
+        return false;
+    }
+
+    if(file.size() == 0)
+    {
+        QDataStream stream(&file);
+        stream.setVersion(QDataStream::Qt_5_0);
+        stream << journal_magic << journal_version;
+    }
+
+    return file.write(data) == data.size() && file.flush();
+}
+
+/**
+ * @brief CookieJournal::write_journal
+ *      Writes the whole journal, one record per cookie. The expired cookies are dropped.
+ * @return
+ *      True if the new file replaced the old one.
+ * @remarks
+ *      Must be called holding the mutex.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+bool CookieJournal::write_journal()
+{
+    if(journal_blocked)
+    {
+        return false;
+    }
+
+    QSaveFile file(SettingsManager::get_filepath() + journal_filename);
+
+    if(!file.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_0);
+    stream << journal_magic << journal_version;
+
+    QDateTime now = QDateTime::currentDateTimeUtc();
+    cookies_count = 0;
+
+    for(QHash<QString, QHash<QByteArray, QNetworkCookie> >::iterator i = users.begin(); i != users.end(); ++i)
+    {
+        QHash<QByteArray, QNetworkCookie>::iterator cookie = i.value().begin();
+
+        while(cookie != i.value().end())
+        {
+            if(cookie.value().isSessionCookie() || cookie.value().expirationDate() > now)
+            {
+                write_record(stream, Insert, i.key(), cookie.value());
+                ++cookie;
+            }
+            else
+            {
+                cookie = i.value().erase(cookie);
+            }
+        }
+
+        cookies_count += i.value().size();
+    }
+
+    records = cookies_count;
+    compactions++;
+
+    return stream.status() == QDataStream::Ok && file.commit();
+}
+
+/**
+ * @brief CookieJournal::cookie_key
+ *      Creates the key that identifies a cookie (name, domain and path), as the cookie jar does.
+ * @param cookie
+ *      The cookie.
+ * @return
+ *      The key.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+QByteArray CookieJournal::cookie_key(const QNetworkCookie &cookie)
+{
+    return cookie.name() + ';' + cookie.domain().toUtf8() + ';' + cookie.path().toUtf8();
+}
+
+/**
+ * @brief CookieJournal::write_record
+ *      Writes a record to the stream. A removal only has the key of the cookie.
+ * @param stream
+ *      The stream.
+ * @param type
+ *      Insert or remove.
+ * @param user
+ *      The name of the user.
+ * @param cookie
+ *      The cookie.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void CookieJournal::write_record(QDataStream &stream, const Record &type, const QString &user, const QNetworkCookie &cookie)
+{
+    stream << static_cast<quint8>(type) << user << cookie.name() << cookie.domain() << cookie.path();
+
+    if(type == Insert)
+    {
+        qint64 expiration = cookie.isSessionCookie() ? -1 : cookie.expirationDate().toMSecsSinceEpoch();
+
+        stream << cookie.value() << expiration << cookie.isSecure() << cookie.isHttpOnly();
+    }
+}
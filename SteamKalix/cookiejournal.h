@@ -0,0 +1,87 @@
+/*
+ * SteamKalix
+ * Copyright (C) 2014 Filipe Carvalho
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef COOKIEJOURNAL_H
+#define COOKIEJOURNAL_H
+
+#include <QNetworkCookie>
+#include <QDataStream>
+#include <QDateTime>
+#include <QSaveFile>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QMutex>
+#include <QHash>
+#include <QList>
+#include <QFile>
+
+#include "defines.h"
+#include "settingsmanager.h"
+#include "cookieset.h"
+
+/**
+ * @brief The CookieJournal class
+ *      Binary storage of the cookies of all users, in the file "cookies.dat" next to the configuration file.
+ *      The file is an append-only journal, a save only appends the cookies that were inserted, changed or removed
+ *      since the last save of the user. The journal is read once, the cookies are kept in memory afterwards.
+ * @remarks
+ *      The records are written with QDataStream, the cookies are loaded field by field (no text parsing).
+ *      A record cut short (e.g. the application crashed while saving) is dropped when the journal is read.
+ * @remarks
+ *      When most records are outdated the journal is compacted: it is rewritten with one record per cookie
+ *      and the expired cookies are dropped. The new file replaces the old one only when complete (QSaveFile).
+ * @remarks
+ *      save_later writes in the background, on a single thread, so the saves are written in the order they were made.
+ *      load and contains do not see the saves still queued, call wait first.
+ * @remarks
+ *      The functions are static and thread-safe.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+class CookieJournal
+{
+
+public_methods:
+    static bool contains(const QString &user);
+    static QList<QNetworkCookie> load(const QString &user);
+    static bool save(const QString &user, const QList<QNetworkCookie> &cookies_list);
+    static void save_later(const QString &user, const CookieSet &cookies);
+    static void wait();
+    static bool compact();
+
+    static QString print();
+
+private_enums:
+    enum Record
+    {
+        Insert = 1,
+        Remove = 2
+    };
+
+private_methods:
+    static void read_journal();
+    static bool append_journal(const QByteArray &data);
+    static bool write_journal();
+
+    static QByteArray cookie_key(const QNetworkCookie &cookie);
+    static void write_record(QDataStream &stream, const Record &type, const QString &user, const QNetworkCookie &cookie);
+
+};
+
+#endif // COOKIEJOURNAL_H
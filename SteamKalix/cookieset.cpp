@@ -0,0 +1,420 @@
+/*
+ * SteamKalix
+ * Copyright (C) 2014 Filipe Carvalho
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "cookieset.h"
+
+/**
+ *@brief Anonymous namespace
+ *      This namespace is used as a "private section".
+ *      It is anonymous and therefore can only accessed within file scope.
+ *@remarks Variables
+ *      The memo keeps at most memo_maximum URLs, it starts over when it is full.
+ *@date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+namespace
+{
+    const int memo_maximum = 256;
+}
+
+/**
+ * @brief CookieSet::Data::Data
+ *      The shared data of the set. The memo is not copied, a detached copy is about to change.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+CookieSet::Data::Data() :
+    count(0)
+{
+}
+
+CookieSet::Data::Data(const Data &other) :
+    QSharedData(other),
+    count(other.count),
+    domains(other.domains)
+{
+}
+
+/**
+ * @brief CookieSet::CookieSet
+ *      Creates an empty set, or a set with the cookies of a list.
+ * @param cookies_list
+ *      The cookies. They are not validated, the list comes from a jar or from the storage.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+CookieSet::CookieSet() :
+    d(new Data())
+{
+}
+
+CookieSet::CookieSet(const QList<QNetworkCookie> &cookies_list) :
+    d(new Data())
+{
+    for(int i = 0; i < cookies_list.size(); i++)
+    {
+        d->domains[domain_key(cookies_list.at(i))].append(cookies_list.at(i));
+    }
+
+    d->count = cookies_list.size();
+}
+
+/**
+ * @brief CookieSet::cookies_for_url
+ *      Gets the cookies to be sent to a URL, from the memo when possible.
+ * @param url
+ *      URL of the request.
+ * @return
+ *      The cookies, the ones with longer paths first (RFC 6265).
+ * @remarks
+ *      This function should be thread-safe for const copies.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+QList<QNetworkCookie> CookieSet::cookies_for_url(const QUrl &url) const
+{
+    QString key = url.scheme() + "://" + url.host().toLower() + url.path();
+    QDateTime now = QDateTime::currentDateTimeUtc();
+
+    d->memo_mutex.lock();
+    QHash<QString, Memo>::const_iterator memo = d->memo.constFind(key);
+
+    if(memo != d->memo.constEnd() && (!memo->valid_until.isValid() || memo->valid_until > now))
+    {
+        QList<QNetworkCookie> cookie_list = memo->cookies;
+        d->memo_mutex.unlock();
+
+        return cookie_list;
+    }
+    d->memo_mutex.unlock();
+
+    Memo result;
+    result.cookies = find(url, result.valid_until);
+
+    d->memo_mutex.lock();
+    if(d->memo.size() >= memo_maximum)
+    {
+        d->memo.clear();
+    }
+
+    d->memo.insert(key, result);
+    d->memo_mutex.unlock();
+
+    return result.cookies;
+}
+
+/**
+ * @brief CookieSet::find
+ *      Finds the cookies of a URL in the index.
+ *      Only the domains of the host are visited, from the host up to the top level domain.
+ * @param url
+ *      URL of the request.
+ * @param valid_until
+ *      Set to the first expiration of the cookies found, invalid if they are all session cookies.
+ * @return
+ *      The cookies, the ones with longer paths first.
+ * @remarks
+ *      Host-only cookies (domain without the leading dot) are only sent to the same host.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+QList<QNetworkCookie> CookieSet::find(const QUrl &url, QDateTime &valid_until) const
+{
+    QList<QNetworkCookie> cookie_list;
+    QDateTime now = QDateTime::currentDateTimeUtc();
+    QString host = url.host().toLower();
+    QString path = url.path().isEmpty() ? "/" : url.path();
+    bool secure = (url.scheme().toLower() == "https");
+
+    QString domain = host;
+    while(!domain.isEmpty())
+    {
+        QHash<QString, QList<QNetworkCookie> >::const_iterator it = d->domains.constFind(domain);
+
+        if(it != d->domains.constEnd())
+        {
+            for(int i = 0; i < it.value().size(); i++)
+            {
+                const QNetworkCookie &cookie = it.value().at(i);
+
+                if((domain != host && !cookie.domain().startsWith('.')) ||
+                   (cookie.isSecure() && !secure) ||
+                   (!cookie.isSessionCookie() && cookie.expirationDate() < now) ||
+                   !is_parent_path(path, cookie.path()))
+                {
+                    continue;
+                }
+
+                if(!cookie.isSessionCookie() && (!valid_until.isValid() || cookie.expirationDate() < valid_until))
+                {
+                    valid_until = cookie.expirationDate();
+                }
+
+                //Longer paths first
+                int position = 0;
+                while(position < cookie_list.size() && cookie_list.at(position).path().length() >= cookie.path().length())
+                {
+                    position++;
+                }
+
+                cookie_list.insert(position, cookie);
+            }
+        }
+
+        int dot = domain.indexOf('.');
+        domain = (dot < 0) ? QString() : domain.mid(dot + 1);
+    }
+
+    return cookie_list;
+}
+
+/**
+ * @brief CookieSet::insert
+ *      Inserts a cookie. A cookie with the same identifier (name, domain and path) is replaced,
+ *      an expired cookie only deletes it.
+ * @param cookie
+ *      The cookie.
+ * @return
+ *      True if the cookie was inserted.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+bool CookieSet::insert(const QNetworkCookie &cookie)
+{
+    bool deletion = !cookie.isSessionCookie() && cookie.expirationDate() < QDateTime::currentDateTimeUtc();
+
+    remove(cookie);
+
+    if(deletion)
+    {
+        return false;
+    }
+
+    d->domains[domain_key(cookie)].append(cookie);
+    d->count++;
+    d->memo.clear();
+
+    return true;
+}
+
+/**
+ * @brief CookieSet::remove
+ *      Removes a cookie.
+ * @param cookie
+ *      The cookie, only the identifier (name, domain and path) is compared.
+ * @return
+ *      True if the cookie was removed.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+bool CookieSet::remove(const QNetworkCookie &cookie)
+{
+    QString key = domain_key(cookie);
+    const Data *data = d.constData();
+    QHash<QString, QList<QNetworkCookie> >::const_iterator found = data->domains.constFind(key);
+
+    //Only detach when there is something to remove
+    if(found == data->domains.constEnd())
+    {
+        return false;
+    }
+
+    for(int i = 0; i < found.value().size(); i++)
+    {
+        if(found.value().at(i).hasSameIdentifier(cookie))
+        {
+            QHash<QString, QList<QNetworkCookie> >::iterator it = d->domains.find(key);
+            it.value().removeAt(i);
+            d->count--;
+            d->memo.clear();
+
+            if(it.value().isEmpty())
+            {
+                d->domains.erase(it);
+            }
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief CookieSet::remove_except
+ *      Removes all the cookies except the ones passed on the list.
+ * @param exclude
+ *      A cookie is kept if its name starts with one of them, e.g. "steamMachineAuth" keeps "steamMachineAuth<steamid>".
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void CookieSet::remove_except(const QStringList &exclude)
+{
+    QList<QByteArray> exclude_names;
+
+    for(int i = 0; i < exclude.size(); i++)
+    {
+        exclude_names.append(exclude.at(i).toUtf8());
+    }
+
+    QHash<QString, QList<QNetworkCookie> >::iterator it = d->domains.begin();
+    while(it != d->domains.end())
+    {
+        QList<QNetworkCookie> &cookie_list = it.value();
+
+        for(int i = cookie_list.size() - 1; i >= 0; i--)
+        {
+            bool found = false;
+
+            for(int j = 0; j < exclude_names.size() && !found; j++)
+            {
+                found = cookie_list.at(i).name().startsWith(exclude_names.at(j));
+            }
+
+            if(!found)
+            {
+                cookie_list.removeAt(i);
+                d->count--;
+            }
+        }
+
+        it = cookie_list.isEmpty() ? d->domains.erase(it) : it + 1;
+    }
+
+    d->memo.clear();
+}
+
+/**
+ * @brief CookieSet::clear
+ *      Removes all the cookies. The other copies of the set keep them.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void CookieSet::clear()
+{
+    d = new Data();
+}
+
+/**
+ * @brief CookieSet::count
+ *      Number of cookies in the set, the count is kept by the index.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+int CookieSet::count() const
+{
+    return d->count;
+}
+
+/**
+ * @brief CookieSet::all_cookies
+ *      Builds the list of all the cookies, use it only to store or pass them on.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+QList<QNetworkCookie> CookieSet::all_cookies() const
+{
+    QList<QNetworkCookie> cookie_list;
+    cookie_list.reserve(d->count);
+
+    QHash<QString, QList<QNetworkCookie> >::const_iterator it;
+    for(it = d->domains.constBegin(); it != d->domains.constEnd(); ++it)
+    {
+        cookie_list.append(it.value());
+    }
+
+    return cookie_list;
+}
+
+/**
+ * @brief CookieSet::raw_form
+ *      Creates an array with the raw form of all the cookies, without building the list.
+ * @param before
+ *      Added before each cookie.
+ * @param after
+ *      Added after each cookie.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+QByteArray CookieSet::raw_form(const QByteArray &before, const QByteArray &after) const
+{
+    QByteArray cookie_storage;
+
+    QHash<QString, QList<QNetworkCookie> >::const_iterator it;
+    for(it = d->domains.constBegin(); it != d->domains.constEnd(); ++it)
+    {
+        for(int i = 0; i < it.value().size(); i++)
+        {
+            cookie_storage.append(before + it.value().at(i).toRawForm() + after);
+        }
+    }
+
+    return cookie_storage;
+}
+
+/**
+ * @brief CookieSet::domain_key
+ *      The key of a cookie in the index, the domain without the leading dot.
+ * @param cookie
+ *      The cookie.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+QString CookieSet::domain_key(const QNetworkCookie &cookie)
+{
+    QString domain = cookie.domain().toLower();
+
+    return domain.startsWith('.') ? domain.mid(1) : domain;
+}
+
+/**
+ * @brief CookieSet::is_parent_path
+ *      Verifies if the path of a cookie matches the path of a request (RFC 6265, 5.1.4).
+ * @param path
+ *      The path of the request.
+ * @param cookie_path
+ *      The path of the cookie.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+bool CookieSet::is_parent_path(const QString &path, const QString &cookie_path)
+{
+    if(cookie_path.isEmpty() || cookie_path == "/")
+    {
+        return true;
+    }
+
+    return path.startsWith(cookie_path) &&
+           (path.length() == cookie_path.length() ||
+            cookie_path.endsWith('/') ||
+            path.at(cookie_path.length()) == '/');
+}
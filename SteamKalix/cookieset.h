@@ -0,0 +1,92 @@
+/*
+ * SteamKalix
+ * Copyright (C) 2014 Filipe Carvalho
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef COOKIESET_H
+#define COOKIESET_H
+
+#include <QNetworkCookie>
+#include <QSharedData>
+#include <QSharedDataPointer>
+#include <QStringList>
+#include <QDateTime>
+#include <QMutex>
+#include <QHash>
+#include <QUrl>
+
+#include "defines.h"
+
+/**
+ * @brief The CookieSet class
+ *      Set of cookies indexed by domain, implicitly shared. Copies share the same data until one of them is changed.
+ *      A lookup only visits the domains of the host (e.g. "store.steampowered.com" and "steampowered.com").
+ * @remarks
+ *      The lookups are memoized by URL (scheme, host and path) in the shared data, every copy of the set
+ *      benefits from them. A result is kept until the first of its cookies expires, any change starts over.
+ * @remarks
+ *      Copies can be read from different threads, the memo has its own lock.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+class CookieSet
+{
+
+public_construct:
+    CookieSet();
+    CookieSet(const QList<QNetworkCookie> &cookies_list);
+
+public_methods:
+    QList<QNetworkCookie> cookies_for_url(const QUrl &url) const;
+    bool insert(const QNetworkCookie &cookie);
+    bool remove(const QNetworkCookie &cookie);
+    void remove_except(const QStringList &exclude);
+    void clear();
+
+    int count() const;
+    QList<QNetworkCookie> all_cookies() const;
+    QByteArray raw_form(const QByteArray &before, const QByteArray &after) const;
+
+private_methods:
+    QList<QNetworkCookie> find(const QUrl &url, QDateTime &valid_until) const;
+    static QString domain_key(const QNetworkCookie &cookie);
+    static bool is_parent_path(const QString &path, const QString &cookie_path);
+
+private_data_members:
+    struct Memo
+    {
+        QList<QNetworkCookie> cookies;
+        QDateTime valid_until;
+    };
+
+    struct Data : public QSharedData
+    {
+        Data();
+        Data(const Data &other);
+
+        int count;
+        QHash<QString, QList<QNetworkCookie> > domains;
+
+        mutable QMutex memo_mutex;
+        mutable QHash<QString, Memo> memo;
+    };
+
+    QSharedDataPointer<Data> d;
+
+};
+
+#endif // COOKIESET_H
@@ -0,0 +1,367 @@
+/*
+ * SteamKalix
+ * Copyright (C) 2014 Filipe Carvalho
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "dnscache.h"
+
+/**
+ *@brief Anonymous namespace
+ *      This namespace is used as a "private section".
+ *      It is anonymous and therefore can only accessed within file scope.
+ *@remarks Variables
+ *      The default time to live is 50 seconds, below the 60 seconds of the Qt host cache.
+ *      The lookups in progress are kept, a host is not looked up twice at the same time.
+ *      A host whose lookups fail is retried after 1, 2, 4... seconds, up to retry_maximum.
+ *@date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+namespace
+{
+    struct Entry
+    {
+        Entry() : fixed(false), failures(0) {}
+
+        QString address;
+        QElapsedTimer resolved;
+        QElapsedTimer failed;
+        bool fixed;
+        int failures;
+    };
+
+    QMutex mutex;
+    QHash<QString, Entry> entries;
+    QSet<QString> lookups;
+    QAtomicInt dns_generation(0);
+    DnsCache *dns_instance = NULL;
+    const int retry_maximum = 64000;
+    int ttl = 50;
+    QAtomicInt hits(0);
+    QAtomicInt misses(0);
+}
+
+/**
+ * @brief DnsCache::DnsCache
+ *      The instance only receives the lookups and runs the refresh timer, the cache is static.
+ *      The timer is started by start_refresh, in the thread of the instance.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+DnsCache::DnsCache(QObject *parent) :
+    QObject(parent),
+    refresh_timer(new QTimer(this))
+{
+    refresh_timer->setInterval(1000);
+    connect(refresh_timer, SIGNAL(timeout()), this, SLOT(refresh()));
+}
+
+/**
+ * @brief DnsCache::instance
+ *      Creates the instance on first use and moves it to the thread of the application.
+ *      The first call may come from any thread, the instance must outlive it to receive the lookups and run the timer.
+ * @remarks
+ *      Must be called holding the mutex.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+DnsCache* DnsCache::instance()
+{
+    if(dns_instance == NULL)
+    {
+        dns_instance = new DnsCache();
+        dns_instance->moveToThread(QCoreApplication::instance()->thread());
+        QMetaObject::invokeMethod(dns_instance, "start_refresh", Qt::QueuedConnection);
+    }
+
+    return dns_instance;
+}
+
+/**
+ * @brief DnsCache::start_refresh
+ *      Starts the refresh timer, in the thread of the application.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void DnsCache::start_refresh()
+{
+    refresh_timer->start();
+}
+
+/**
+ * @brief DnsCache::resolve
+ *      Adds the hosts to the cache and looks up the ones that are not resolved yet.
+ *      It returns immediately, the addresses are available when the lookups finish.
+ * @param hosts
+ *      Host names. Addresses and empty names are ignored.
+ * @remarks
+ *      This function should be thread-safe.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void DnsCache::resolve(const QStringList &hosts)
+{
+    QStringList new_hosts;
+
+    mutex.lock();
+    DnsCache *cache = instance();
+
+    for(int i = 0; i < hosts.size(); i++)
+    {
+        QString host = hosts.at(i).toLower();
+
+        if(!host.isEmpty() && QHostAddress(host).isNull() && !entries.contains(host) && !lookups.contains(host))
+        {
+            entries.insert(host, Entry());
+            lookups.insert(host);
+            new_hosts.append(host);
+        }
+    }
+    mutex.unlock();
+
+    cache->lookup(new_hosts);
+}
+
+/**
+ * @brief DnsCache::address
+ *      Gets the address of a host, without waiting.
+ * @param host
+ *      Host name.
+ * @return
+ *      The address. The host itself if it was not resolved yet (miss), the network stack will resolve it.
+ * @remarks
+ *      This function should be thread-safe.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+QString DnsCache::address(const QString &host)
+{
+    mutex.lock();
+    QString host_address = entries.value(host.toLower()).address;
+
+    if(host_address.isEmpty())
+    {
+        misses.ref();
+        host_address = host;
+    }
+    else
+    {
+        hits.ref();
+    }
+    mutex.unlock();
+
+    return host_address;
+}
+
+/**
+ * @brief DnsCache::set_host
+ *      Sets a fixed address for a host, it is never looked up or expired.
+ * @param host
+ *      Host name.
+ * @param address
+ *      The address. A null address removes the fixed entry, the host is looked up again.
+ * @remarks
+ *      This function should be thread-safe.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void DnsCache::set_host(const QString &host, const QHostAddress &address)
+{
+    mutex.lock();
+    if(address.isNull())
+    {
+        entries.remove(host.toLower());
+    }
+    else
+    {
+        Entry &entry = entries[host.toLower()];
+        entry.address = address.toString();
+        entry.fixed = true;
+    }
+    mutex.unlock();
+
+    dns_generation.fetchAndAddRelease(1);
+}
+
+/**
+ * @brief DnsCache::set_ttl
+ *      Sets the time to live of the addresses, they are refreshed in the background when it expires.
+ * @param seconds
+ *      Time to live, at least 1 second.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void DnsCache::set_ttl(const int &seconds)
+{
+    mutex.lock();
+    ttl = qMax(1, seconds);
+    mutex.unlock();
+}
+
+/**
+ * @brief DnsCache::lookup
+ *      Starts the lookups of the hosts, they must be already marked as in progress.
+ * @param hosts
+ *      Host names.
+ * @remarks
+ *      Must be called without holding the mutex, a cached result is delivered before lookupHost returns.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void DnsCache::lookup(const QStringList &hosts)
+{
+    for(int i = 0; i < hosts.size(); i++)
+    {
+        QHostInfo::lookupHost(hosts.at(i), this, SLOT(lookup_finished(QHostInfo)));
+    }
+}
+
+/**
+ * @brief DnsCache::lookup_finished
+ *      This slot is received when a lookup finishes.
+ *      Stores the first address of the host, a failed lookup keeps the previous one and delays the next retry.
+ * @param host_info
+ *      Result of the lookup.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void DnsCache::lookup_finished(const QHostInfo &host_info)
+{
+    bool changed = false;
+
+    mutex.lock();
+    QString host = host_info.hostName().toLower();
+    lookups.remove(host);
+    QHash<QString, Entry>::iterator entry = entries.find(host);
+
+    if(entry != entries.end() && !entry->fixed)
+    {
+        if(host_info.error() == QHostInfo::NoError && !host_info.addresses().isEmpty())
+        {
+            QString host_address = host_info.addresses().first().toString();
+            changed = (entry->address != host_address);
+
+            entry->address = host_address;
+            entry->resolved.start();
+            entry->failures = 0;
+        }
+        else
+        {
+            entry->failures++;
+            entry->failed.start();
+        }
+    }
+    mutex.unlock();
+
+    if(changed)
+    {
+        dns_generation.fetchAndAddRelease(1);
+    }
+}
+
+/**
+ * @brief DnsCache::refresh
+ *      This slot is received from the refresh timer, every second.
+ *      Looks up again the hosts whose address expired, the old address is used until the new one arrives.
+ *      A host whose last lookups failed waits for its backoff, 1 second doubled by each failure up to retry_maximum.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void DnsCache::refresh()
+{
+    QStringList expired_hosts;
+
+    mutex.lock();
+    QHash<QString, Entry>::const_iterator it;
+    for(it = entries.constBegin(); it != entries.constEnd(); ++it)
+    {
+        bool expired = !it->resolved.isValid() || it->resolved.hasExpired(ttl * 1000);
+        bool backoff = it->failures > 0 && !it->failed.hasExpired(qMin(1000 << qMin(it->failures - 1, 6), retry_maximum));
+
+        if(!it->fixed && !lookups.contains(it.key()) && expired && !backoff)
+        {
+            lookups.insert(it.key());
+            expired_hosts.append(it.key());
+        }
+    }
+    mutex.unlock();
+
+    lookup(expired_hosts);
+}
+
+/**
+ * @brief DnsCache::generation
+ *      Incremented every time an address changes, the users of the addresses compare it to refresh them.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+int DnsCache::generation()
+{
+    return dns_generation.loadAcquire();
+}
+
+/**
+ * @brief DnsCache::get_hits
+ * @brief DnsCache::get_misses
+ *      Number of addresses that were (hit) or were not (miss) resolved when asked.
+ * @remarks
+ *      The counters are atomic, they are read without the mutex.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+int DnsCache::get_hits()
+{
+    return hits.loadAcquire();
+}
+
+int DnsCache::get_misses()
+{
+    return misses.loadAcquire();
+}
+
+/**
+ * @brief DnsCache::print
+ *      Creates a string with the state of the cache.
+ *      Use and output method that supports HTML.
+ * @return
+ *      Data to be displayed
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+QString DnsCache::print()
+{
+    mutex.lock();
+    QString cache_print = "Hosts: " + QString::number(entries.size()) +
+                          " - Lookups: " + QString::number(lookups.size()) +
+                          " - Hits: " + QString::number(hits.loadAcquire()) +
+                          " - Misses: " + QString::number(misses.loadAcquire());
+    mutex.unlock();
+
+    return cache_print;
+}
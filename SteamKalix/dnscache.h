@@ -0,0 +1,84 @@
+/*
+ * SteamKalix
+ * Copyright (C) 2014 Filipe Carvalho
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef DNSCACHE_H
+#define DNSCACHE_H
+
+#include <QObject>
+#include <QCoreApplication>
+#include <QTimer>
+#include <QHostInfo>
+#include <QHostAddress>
+#include <QElapsedTimer>
+#include <QStringList>
+#include <QAtomicInt>
+#include <QMutex>
+#include <QHash>
+#include <QSet>
+
+#include "defines.h"
+
+/**
+ * @brief The DnsCache class
+ *      Resolves the hosts of the application ahead of time (proxys and Steam), so no request waits on DNS.
+ *      The lookups are asynchronous, the addresses are kept for a time to live and refreshed in the background.
+ *      A failed refresh keeps the last address, a host that was resolved once is never missing.
+ *      Failed lookups are retried with a backoff, from 1 second up to 64 seconds.
+ * @remarks
+ *      The network managers connect to the proxys by address (see NetworkManager::resolve_hosts).
+ *      The Steam hosts are resolved by the proxy, or by the sockets for direct connections, which use the Qt host cache
+ *      warmed by these lookups.
+ * @remarks
+ *      Fixed hosts (set_host) are never looked up, e.g. to point the hosts to a local server in tests.
+ * @remarks
+ *      Qt does not expose the TTL of the records, the time to live is the same for all hosts (set_ttl).
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+class DnsCache : public QObject
+{
+    Q_OBJECT
+
+public_methods:
+    static void resolve(const QStringList &hosts);
+    static QString address(const QString &host);
+    static void set_host(const QString &host, const QHostAddress &address);
+    static void set_ttl(const int &seconds);
+    static int generation();
+
+    static int get_hits();
+    static int get_misses();
+    static QString print();
+
+private_methods:
+    explicit DnsCache(QObject *parent = 0);
+    static DnsCache* instance();
+    void lookup(const QStringList &hosts);
+
+private_data_members:
+    QTimer *refresh_timer;
+
+private slots:
+    void start_refresh();
+    void lookup_finished(const QHostInfo &host_info);
+    void refresh();
+
+};
+
+#endif // DNSCACHE_H
@@ -0,0 +1,556 @@
+/*
+ * SteamKalix
+ * Copyright (C) 2014 Filipe Carvalho
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "jsonstream.h"
+
+/**
+ *@brief Anonymous namespace
+ *      This namespace is used as a "private section".
+ *      It is anonymous and therefore can only accessed within file scope.
+ *@remarks Steps
+ *      The step of a container frame is what the parser expects next.
+ *      Objects go through all of them, arrays only use expect_value and expect_separator.
+ *@remarks Segments
+ *      Each segment of a field is also kept as an index: segment_any for "*", segment_key if it is not a number.
+ *@remarks Keys
+ *      The keys are received raw, decode_string decodes their escapes (including \u and surrogate pairs).
+ *@date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+namespace
+{
+    const int expect_key = 0;
+    const int expect_colon = 1;
+    const int expect_value = 2;
+    const int expect_separator = 3;
+
+    const int segment_any = -2;
+    const int segment_key = -1;
+    const int patterns_maximum = 64;
+
+    bool is_whitespace(const char &c)
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    bool decode_string(const QByteArray &token, QString &decoded)
+    {
+        QByteArray utf8;
+        utf8.reserve(token.size());
+
+        for(int i = 0; i < token.size(); i++)
+        {
+            if(token.at(i) != '\\')
+            {
+                utf8.append(token.at(i));
+                continue;
+            }
+
+            if(++i >= token.size())
+            {
+                return false;
+            }
+
+            switch(token.at(i))
+            {
+            case '"':
+            case '\\':
+            case '/':
+                utf8.append(token.at(i));
+                break;
+            case 'b':
+                utf8.append('\b');
+                break;
+            case 'f':
+                utf8.append('\f');
+                break;
+            case 'n':
+                utf8.append('\n');
+                break;
+            case 'r':
+                utf8.append('\r');
+                break;
+            case 't':
+                utf8.append('\t');
+                break;
+            case 'u':
+            {
+                bool ok = false;
+                ushort unit = (i + 4 < token.size()) ? token.mid(i + 1, 4).toUShort(&ok, 16) : 0;
+
+                if(!ok)
+                {
+                    return false;
+                }
+
+                i += 4;
+                QString character(QChar(unit));
+
+                //Characters outside the BMP are a pair of escapes
+                if(QChar::isHighSurrogate(unit) && i + 6 < token.size() && token.at(i + 1) == '\\' && token.at(i + 2) == 'u')
+                {
+                    ushort low = token.mid(i + 3, 4).toUShort(&ok, 16);
+
+                    if(ok && QChar::isLowSurrogate(low))
+                    {
+                        character.append(QChar(low));
+                        i += 6;
+                    }
+                }
+
+                utf8.append(character.toUtf8());
+                break;
+            }
+            default:
+                return false;
+            }
+        }
+
+        decoded = QString::fromUtf8(utf8);
+        return true;
+    }
+}
+
+/**
+ * @brief JsonStream::JsonStream
+ *      Initializes the parser.
+ * @param fields
+ *      Paths of the values to extract, see the class remarks. Only the first 64 are used.
+ * @param parent
+ *      The owner of the parser, usually a NetworkFuture.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+JsonStream::JsonStream(const QStringList &fields, QObject *parent) :
+    QObject(parent),
+    mode(structure),
+    string_key(false),
+    escape(false),
+    root_done(false),
+    error(false),
+    capture_depth(-1),
+    patterns_all(0)
+{
+    for(int i = 0; i < fields.size() && i < patterns_maximum; i++)
+    {
+        QStringList pattern = fields.at(i).split('.', QString::SkipEmptyParts);
+        QVector<int> indexes(pattern.size());
+
+        for(int j = 0; j < pattern.size(); j++)
+        {
+            bool number = false;
+            int index = pattern.at(j).toInt(&number);
+            indexes[j] = (pattern.at(j) == "*") ? segment_any : ((number && index >= 0) ? index : segment_key);
+        }
+
+        patterns.append(pattern);
+        patterns_indexes.append(indexes);
+        patterns_all |= (Q_UINT64_C(1) << i);
+    }
+}
+
+/**
+ * @brief JsonStream::append
+ *      Parses the next chunk of the document.
+ * @param data
+ *      The chunk, it can end anywhere (in the middle of a string or number).
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void JsonStream::append(const QByteArray &data)
+{
+    const char *chunk = data.constData();
+    int size = data.size();
+
+    for(int i = 0; i < size && !error; i++)
+    {
+        parse(chunk[i]);
+    }
+}
+
+/**
+ * @brief JsonStream::finish
+ *      Ends the document. A number or literal at the root only ends here.
+ *      An incomplete document is an error.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void JsonStream::finish()
+{
+    if(mode == in_scalar && stack.isEmpty())
+    {
+        mode = structure;
+        end_value();
+    }
+
+    if(!root_done)
+    {
+        error = true;
+    }
+}
+
+/**
+ * @brief JsonStream::parse
+ *      Advances the parser by one byte.
+ * @param c
+ *      The byte.
+ * @remarks
+ *      While a field is captured every byte is kept, the terminator of a number or literal is removed at the end.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void JsonStream::parse(const char &c)
+{
+    if(capture_depth >= 0)
+    {
+        capture.append(c);
+    }
+
+    if(mode == in_string)
+    {
+        if(escape)
+        {
+            escape = false;
+        }
+        else if(c == '\\')
+        {
+            escape = true;
+        }
+        else if(c == '"')
+        {
+            mode = structure;
+            end_string();
+            return;
+        }
+
+        if(string_key)
+        {
+            token.append(c);
+        }
+
+        return;
+    }
+
+    if(mode == in_scalar)
+    {
+        if(c != ',' && c != '}' && c != ']' && !is_whitespace(c))
+        {
+            return;
+        }
+
+        if(capture_depth == stack.size())
+        {
+            capture.chop(1);
+        }
+
+        mode = structure;
+        end_value();
+    }
+
+    if(is_whitespace(c))
+    {
+        return;
+    }
+
+    if(stack.isEmpty())
+    {
+        if(root_done)
+        {
+            error = true;
+        }
+        else
+        {
+            begin_value(c);
+        }
+
+        return;
+    }
+
+    Frame &frame = stack.last();
+
+    if(frame.step == expect_key)
+    {
+        if(c == '"')
+        {
+            mode = in_string;
+            string_key = true;
+            token.clear();
+        }
+        else if(c == '}')
+        {
+            close_container();
+        }
+        else
+        {
+            error = true;
+        }
+    }
+    else if(frame.step == expect_colon)
+    {
+        if(c == ':')
+        {
+            frame.step = expect_value;
+        }
+        else
+        {
+            error = true;
+        }
+    }
+    else if(frame.step == expect_separator)
+    {
+        if(c == ',')
+        {
+            frame.step = frame.object ? expect_key : expect_value;
+            frame.index++;
+        }
+        else if(c == (frame.object ? '}' : ']'))
+        {
+            close_container();
+        }
+        else
+        {
+            error = true;
+        }
+    }
+    else if(!frame.object && c == ']')
+    {
+        close_container();
+    }
+    else
+    {
+        begin_value(c);
+    }
+}
+
+/**
+ * @brief JsonStream::begin_value
+ *      Starts a value, and its capture if the path is one of the fields.
+ *      The fields that match the path so far come from the container, only the last segment is compared.
+ *      The path is only built for a value that is captured.
+ * @param c
+ *      The first byte of the value.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void JsonStream::begin_value(const char &c)
+{
+    quint64 candidates = 0;
+
+    if(capture_depth < 0)
+    {
+        int depth = stack.size();
+        candidates = stack.isEmpty() ? patterns_all : match(stack.last().candidates, depth - 1, stack.last());
+
+        //A field of the same length as the path is complete
+        for(int i = 0; i < patterns.size() && capture_depth < 0; i++)
+        {
+            if((candidates & (Q_UINT64_C(1) << i)) != 0 && patterns.at(i).size() == depth)
+            {
+                QStringList path;
+                for(int j = 0; j < depth; j++)
+                {
+                    path.append(stack.at(j).object ? stack.at(j).key : QString::number(stack.at(j).index));
+                }
+
+                capture_depth = depth;
+                capture_path = path.join(".");
+                capture = QByteArray(1, c);
+            }
+        }
+    }
+
+    if(c == '{' || c == '[')
+    {
+        Frame frame;
+        frame.object = (c == '{');
+        frame.step = frame.object ? expect_key : expect_value;
+        frame.index = 0;
+        frame.candidates = (capture_depth < 0) ? candidates : 0;
+        stack.append(frame);
+    }
+    else if(c == '"')
+    {
+        mode = in_string;
+        string_key = false;
+    }
+    else
+    {
+        mode = in_scalar;
+    }
+}
+
+/**
+ * @brief JsonStream::end_value
+ *      Ends a value. If it was captured, it is parsed and found() is emitted.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void JsonStream::end_value()
+{
+    if(capture_depth == stack.size())
+    {
+        QJsonParseError parse_error;
+        QJsonDocument document = QJsonDocument::fromJson("[" + capture + "]", &parse_error);
+        capture_depth = -1;
+        capture.clear();
+
+        if(parse_error.error == QJsonParseError::NoError)
+        {
+            QJsonValue value = document.array().at(0);
+            results.insert(capture_path, value);
+
+            emit found(capture_path, value);
+        }
+        else
+        {
+            error = true;
+        }
+    }
+
+    if(stack.isEmpty())
+    {
+        root_done = true;
+    }
+    else
+    {
+        stack.last().step = expect_separator;
+    }
+}
+
+/**
+ * @brief JsonStream::end_string
+ *      Ends a string, either a key or a value.
+ * @remarks
+ *      The escapes of a key are decoded (decode_string) before it is compared to the fields, e.g. "a\"b" is a"b.
+ *      Keys without escapes, almost all, are converted directly. An invalid escape is an error.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void JsonStream::end_string()
+{
+    if(string_key)
+    {
+        Frame &frame = stack.last();
+
+        if(token.contains('\\'))
+        {
+            if(!decode_string(token, frame.key))
+            {
+                error = true;
+            }
+        }
+        else
+        {
+            frame.key = QString::fromUtf8(token);
+        }
+
+        frame.step = expect_colon;
+        string_key = false;
+    }
+    else
+    {
+        end_value();
+    }
+}
+
+/**
+ * @brief JsonStream::close_container
+ *      Ends the object or array on the top of the stack.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void JsonStream::close_container()
+{
+    stack.removeLast();
+    end_value();
+}
+
+/**
+ * @brief JsonStream::match
+ *      Filters the fields that match a path, by the segment of the path at a depth.
+ * @param candidates
+ *      Mask of the fields that match the path up to the depth, from the container.
+ * @param depth
+ *      Depth of the segment.
+ * @param frame
+ *      The container, its current key or index is the segment.
+ * @return
+ *      Mask of the fields that still match. Nothing is allocated.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+quint64 JsonStream::match(const quint64 &candidates, const int &depth, const Frame &frame) const
+{
+    quint64 matched = 0;
+
+    for(int i = 0; i < patterns.size() && (candidates >> i) != 0; i++)
+    {
+        if((candidates & (Q_UINT64_C(1) << i)) == 0 || patterns.at(i).size() <= depth)
+        {
+            continue;
+        }
+
+        int index = patterns_indexes.at(i).at(depth);
+
+        if(index == segment_any || (frame.object ? patterns.at(i).at(depth) == frame.key : index == frame.index))
+        {
+            matched |= (Q_UINT64_C(1) << i);
+        }
+    }
+
+    return matched;
+}
+
+/**
+ * @brief JsonStream::Getters
+ *      The following functions are used to retrive the state and the extracted values.
+ * @remarks
+ *      value() returns an undefined value if the field was not found (yet).
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+bool JsonStream::is_finished() const
+{
+    return root_done;
+}
+
+bool JsonStream::has_error() const
+{
+    return error;
+}
+
+QJsonValue JsonStream::value(const QString &path) const
+{
+    return results.value(path, QJsonValue(QJsonValue::Undefined));
+}
+
+QHash<QString, QJsonValue> JsonStream::values() const
+{
+    return results;
+}
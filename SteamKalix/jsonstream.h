@@ -0,0 +1,113 @@
+/*
+ * SteamKalix
+ * Copyright (C) 2014 Filipe Carvalho
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef JSONSTREAM_H
+#define JSONSTREAM_H
+
+#include <QObject>
+#include <QStringList>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QJsonValue>
+#include <QVector>
+#include <QHash>
+
+#include "defines.h"
+
+/**
+ * @brief The JsonStream class
+ *      Incremental JSON parser, fed with the chunks of a reply while they arrive.
+ *      Only the fields of interest are extracted, the rest of the document is skipped without being stored,
+ *      so a large reply never needs a full-body buffer.
+ * @remarks Fields
+ *      A field is the path of a value, with the keys (or array indexes) separated by dots.
+ *      A "*" matches any key or index. E.g. "success", "transfer_parameters", "listinginfo.*.price".
+ *      A field can be an object or array, it is extracted as a whole (fields inside it are not reported again).
+ *      Up to 64 fields, the fields that still match are kept per container as a mask, no path is built per value.
+ * @remarks
+ *      found() is emitted as soon as each value is complete, so the receiver can decide before the last byte,
+ *      e.g. cancel the request.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+class JsonStream : public QObject
+{
+    Q_OBJECT
+
+public_construct:
+    explicit JsonStream(const QStringList &fields, QObject *parent = 0);
+
+public_methods:
+    void append(const QByteArray &data);
+    void finish();
+
+    bool is_finished() const;
+    bool has_error() const;
+    QJsonValue value(const QString &path) const;
+    QHash<QString, QJsonValue> values() const;
+
+private_methods:
+    struct Frame;
+    void parse(const char &c);
+    void begin_value(const char &c);
+    void end_value();
+    void end_string();
+    void close_container();
+    quint64 match(const quint64 &candidates, const int &depth, const Frame &frame) const;
+
+private_members:
+    enum Mode
+    {
+        structure,
+        in_string,
+        in_scalar
+    };
+
+    Mode mode;
+    bool string_key;
+    bool escape;
+    bool root_done;
+    bool error;
+    int capture_depth;
+
+private_data_members:
+    struct Frame
+    {
+        bool object;
+        int step;
+        int index;
+        QString key;
+        quint64 candidates;
+    };
+
+    QVector<Frame> stack;
+    QList<QStringList> patterns;
+    QList<QVector<int> > patterns_indexes;
+    quint64 patterns_all;
+    QByteArray token;
+    QByteArray capture;
+    QString capture_path;
+    QHash<QString, QJsonValue> results;
+
+signals:
+    void found(const QString &path, const QJsonValue &value);
+
+};
+
+#endif // JSONSTREAM_H
@@ -0,0 +1,193 @@
+/*
+ * SteamKalix
+ * Copyright (C) 2014 Filipe Carvalho
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "latencyhistogram.h"
+
+/**
+ *@brief Anonymous namespace
+ *      This namespace is used as a "private section".
+ *      It is anonymous and therefore can only accessed within file scope.
+ *@remarks Variables
+ *      Latencies above latency_limit are counted in the last bucket.
+ *      The window is the number of samples kept before the buckets are halved.
+ *@date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+namespace
+{
+    const int latency_limit = (1 << 17) - 1;
+    const int buckets_size = 64;
+    const int window = 1024;
+}
+
+/**
+ * @brief LatencyHistogram::LatencyHistogram
+ *      Initializes an empty histogram.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+LatencyHistogram::LatencyHistogram() :
+    samples(0),
+    buckets(buckets_size, 0)
+{
+}
+
+/**
+ * @brief LatencyHistogram::add
+ *      Adds a sample to the histogram.
+ * @param latency
+ *      Latency of the request, in milliseconds.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void LatencyHistogram::add(const int &latency)
+{
+    if(samples >= window)
+    {
+        samples = 0;
+
+        for(int i = 0; i < buckets.size(); i++)
+        {
+            buckets[i] /= 2;
+            samples += buckets.at(i);
+        }
+    }
+
+    buckets[bucket(latency)]++;
+    samples++;
+}
+
+/**
+ * @brief LatencyHistogram::percentile
+ *      Latency below which the given percentage of the samples falls.
+ * @param percent
+ *      Percentile to calculate, from 0 to 100.
+ * @return
+ *      The upper limit of the bucket of the percentile, 0 if the histogram is empty.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+int LatencyHistogram::percentile(const double &percent) const
+{
+    if(samples == 0)
+    {
+        return 0;
+    }
+
+    int target = qMax(1, qCeil(samples * percent / 100.0));
+    int total = 0;
+
+    for(int i = 0; i < buckets.size(); i++)
+    {
+        total += buckets.at(i);
+
+        if(total >= target)
+        {
+            return bucket_limit(i);
+        }
+    }
+
+    return latency_limit;
+}
+
+/**
+ * @brief LatencyHistogram::count
+ *      Number of samples in the current window.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+int LatencyHistogram::count() const
+{
+    return samples;
+}
+
+/**
+ * @brief LatencyHistogram::bucket
+ *      Index of the bucket of a latency. The first 4 buckets are exact, the following have 4 buckets per power of two.
+ * @param latency
+ *      Latency in milliseconds.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+int LatencyHistogram::bucket(const int &latency)
+{
+    int value = qBound(0, latency, latency_limit);
+
+    if(value < 4)
+    {
+        return value;
+    }
+
+    int exponent = 2;
+
+    while((value >> (exponent + 1)) != 0)
+    {
+        exponent++;
+    }
+
+    return 4 + (exponent - 2) * 4 + ((value >> (exponent - 2)) & 3);
+}
+
+/**
+ * @brief LatencyHistogram::bucket_limit
+ *      Highest latency of a bucket, the inverse of bucket().
+ * @param index
+ *      Index of the bucket.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+int LatencyHistogram::bucket_limit(const int &index)
+{
+    if(index < 4)
+    {
+        return index;
+    }
+
+    int exponent = (index - 4) / 4 + 2;
+    int sub_bucket = (index - 4) % 4;
+
+    return ((4 + sub_bucket + 1) << (exponent - 2)) - 1;
+}
+
+/**
+ * @brief LatencyHistogram::print
+ *      Creates a string with the main percentiles of the histogram.
+ * @return
+ *      Data to be displayed
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+QString LatencyHistogram::print() const
+{
+    QString histogram_print;
+
+    histogram_print.append("Samples: " + QString::number(samples) + " - ");
+    histogram_print.append("p50: " + QString::number(percentile(50)) + "ms - ");
+    histogram_print.append("p90: " + QString::number(percentile(90)) + "ms - ");
+    histogram_print.append("p99: " + QString::number(percentile(99)) + "ms");
+
+    return histogram_print;
+}
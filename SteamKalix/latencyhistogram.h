@@ -0,0 +1,64 @@
+/*
+ * SteamKalix
+ * Copyright (C) 2014 Filipe Carvalho
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include <QVector>
+#include <QString>
+#include <QtMath>
+
+#include "defines.h"
+
+/**
+ * @brief The LatencyHistogram class
+ *      Streaming histogram of the latencies of a route, in milliseconds.
+ *      The buckets are log-linear (4 buckets per power of two), so percentiles have at most 25% of error
+ *      with a fixed amount of memory, from 1ms up to 131 seconds.
+ * @remarks
+ *      When the window is full all the buckets are halved, old samples fade and the histogram follows the live latency.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+class LatencyHistogram
+{
+
+public_construct:
+    LatencyHistogram();
+
+public_methods:
+    void add(const int &latency);
+    int percentile(const double &percent) const;
+    int count() const;
+
+    QString print() const;
+
+private_methods:
+    static int bucket(const int &latency);
+    static int bucket_limit(const int &index);
+
+private_members:
+    int samples;
+
+private_data_members:
+    QVector<int> buckets;
+
+};
+
+#endif // LATENCYHISTOGRAM_H
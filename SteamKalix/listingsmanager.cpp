@@ -26,16 +26,16 @@ ListingsManager::ListingsManager(QObject *parent) :
     network_manager(new NetworkManager(this))
 {
     connect(timer, SIGNAL(timeout()), this, SLOT(work()));
-    connect(network_manager, SIGNAL(finished(QNetworkReply*)), this, SLOT(process_request(QNetworkReply*)));
 
+    //Listings poll the same market pages
+    network_manager->set_coalescing(true);
+    network_manager->set_caching(true);
+
+    //The market answers 429 to bursts
+    network_manager->set_limits(4, 2, 2, 4);
 }
 
 void ListingsManager::work()
 {
 
 }
-
-void ListingsManager::process_request(QNetworkReply *reply)
-{
-    reply->deleteLater();
-}
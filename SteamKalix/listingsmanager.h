@@ -52,7 +52,6 @@ public slots:
 
 private slots:
     void work();
-    void process_request(QNetworkReply *reply);
 
 signals:
     void console(const QString &message);
@@ -97,7 +97,7 @@ Login::Login(QObject *parent) :
  * @param proxy_password
  * @date
  *      Created:  Filipe, 2 Jan 2014
- *      Modified: Filipe, 7 Mar 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
 void Login::do_login(const QVariantHash &options)
 {
@@ -123,6 +123,9 @@ void Login::do_login(const QVariantHash &options)
         network_manager->set_proxy(QNetworkProxy::NoProxy);
     }
 
+    //Resolve the proxys and the Steam hosts while the login runs.
+    network_manager->resolve_hosts();
+
     output(network_manager->print(), 3);
 
     //Set captcha and steamguard code.
@@ -140,7 +143,7 @@ void Login::do_login(const QVariantHash &options)
  *      Requests the server to logout.
  * @date
  *      Created:  Filipe, 7 Mar 2014
- *      Modified: Filipe, 7 Jun 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
 void Login::do_logout(const QString &username_logout)
 {
@@ -154,10 +157,7 @@ void Login::do_logout(const QString &username_logout)
     username = username_logout;
     network_manager->load_settings(username);
 
-    disconnect(network_manager, SIGNAL(finished(QNetworkReply*)), this, NULL);
-    connect(network_manager, SIGNAL(finished(QNetworkReply*)), this, SLOT(process_logout(QNetworkReply*)));
-
-    network_manager->getHTTP(url_logout);
+    network_manager->getHTTP_async(url_logout)->then(this, SLOT(process_logout(NetworkFuture*)));
 }
 
 /**
@@ -166,15 +166,15 @@ void Login::do_logout(const QString &username_logout)
  * @remarks
  *      DEPRECATED: Delete cookies if 'remember_login' is true, because they are cleaned in complete_login if not.
  *      UPDATE:     Cookies will always be cleared because with multiple logins we dont know the option chosen at login.
- * @param reply
+ * @param future
  *      The reply from the logout request.
  * @date
  *      Created:  Filipe, 7 Mar 2014
- *      Modified: Filipe, 7 Jun 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
-void Login::process_logout(QNetworkReply *reply)
+void Login::process_logout(NetworkFuture *future)
 {
-    if(reply->error() == QNetworkReply::NoError)
+    if(future->error() == QNetworkReply::NoError)
     {
         if(network_manager->cookiejar()->load(username, true) > 0)
         {
@@ -193,11 +193,11 @@ void Login::process_logout(QNetworkReply *reply)
     }
     else
     {
-        output("Network Error: " + reply->errorString(), 1);
+        output("Network Error: " + future->error_string(), 1);
         emit unlock_login();
     }
 
-    reply->deleteLater();
+    future->deleteLater();
 }
 
 /**
@@ -205,7 +205,7 @@ void Login::process_logout(QNetworkReply *reply)
  *      Calls the right function according to the state.
  * @date
  *      Created:  Filipe, 7 Mar 2014
- *      Modified: Filipe, 7 Mar 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
 void Login::process_state()
 {
@@ -246,7 +246,7 @@ void Login::process_state()
  *      Else, we clear ALL the cookies because we want a fresh login (No record in file, new machine).
  * @date
  *      Created:  Filipe, 6 Mar 2014
- *      Modified: Filipe, 27 Apr 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
 void Login::request_persistent()
 {
@@ -256,10 +256,7 @@ void Login::request_persistent()
     {
         output("Logging in with cookies...", 1);
 
-        disconnect(network_manager, SIGNAL(finished(QNetworkReply*)), this, NULL);
-        connect(network_manager, SIGNAL(finished(QNetworkReply*)), this, SLOT(process_persistent(QNetworkReply*)));
-
-        network_manager->getHTTP(url_account);
+        network_manager->getHTTP_async(url_account)->then(this, SLOT(process_persistent(NetworkFuture*)));
     }
     else if(loaded_cookies > 0)
     {
@@ -284,17 +281,17 @@ void Login::request_persistent()
  *      If the reply is empty, it means that the server has redirected the request to the login page.
  *      This means that the cookies could not log the user, and a new login has to be made.
  *      If the reply is NOT empty, the server replied with the HTML data from the "account" page.
- * @param reply
+ * @param future
  *      The replay from the test login.
  * @date
  *      Created:  Filipe, 6 Mar 2014
- *      Modified: Filipe, 6 Mar 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
-void Login::process_persistent(QNetworkReply *reply)
+void Login::process_persistent(NetworkFuture *future)
 {
-    if(reply->error() == QNetworkReply::NoError)
+    if(future->error() == QNetworkReply::NoError)
     {
-        QByteArray buffer = reply->read(reply->bytesAvailable());
+        QByteArray buffer = future->body();
 
         if(buffer == "")
         {
@@ -310,11 +307,11 @@ void Login::process_persistent(QNetworkReply *reply)
     }
     else
     {
-        output("Network Error: " + reply->errorString(), 1);
+        output("Network Error: " + future->error_string(), 1);
         emit unlock_login();
     }
 
-    reply->deleteLater();
+    future->deleteLater();
 }
 
 /**
@@ -322,7 +319,7 @@ void Login::process_persistent(QNetworkReply *reply)
  *      Query the server for and RSA key and triggers the process_rsa slot.
  * @date
  *      Created:  Filipe, 5 Feb 2014
- *      Modified: Filipe, 12 Feb 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
 void Login::request_rsa()
 {
@@ -332,36 +329,32 @@ void Login::request_rsa()
     parameters.addQueryItem("username", username);
     parameters.addQueryItem("l", "english"); 
 
-    disconnect(network_manager, SIGNAL(finished(QNetworkReply*)), this, NULL);
-    connect(network_manager, SIGNAL(finished(QNetworkReply*)), this, SLOT(process_rsa(QNetworkReply*)));
-
-    network_manager->postHTTP(url_getrsakey, parameters);
+    NetworkFuture *future = network_manager->postHTTP_async(url_getrsakey, parameters);
+    future->stream(QStringList() << "success" << "publickey_mod" << "publickey_exp" << "timestamp");
+    future->then(this, SLOT(process_rsa(NetworkFuture*)));
 }
 
 /**
  * @brief Login::process_rsa
  *      Processes RSA data, encrypts the password and sends the request for the authentication.
- * @param reply
+ * @param future
  *      The result from the RSA data request.
  * @date
  *      Created:  Filipe, 3 Jan 2014
- *      Modified: Filipe, 7 Mar 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
-void Login::process_rsa(QNetworkReply *reply)
+void Login::process_rsa(NetworkFuture *future)
 {
-    if(reply->error() == QNetworkReply::NoError)
+    if(future->error() == QNetworkReply::NoError)
     {
-        QByteArray buffer = reply->read(reply->bytesAvailable());
-        QJsonObject json_object = QJsonDocument::fromJson(buffer).object();
-
-        if(json_object.value("success").toBool())
+        if(future->value("success").toBool())
         {
             output("Generating RSA public key.", 2);
-            output("Key modulus: " + json_object.value("publickey_mod").toString(), 3);
-            output("Key exponent: " + json_object.value("publickey_exp").toString(), 3);
+            output("Key modulus: " + future->value("publickey_mod").toString(), 3);
+            output("Key exponent: " + future->value("publickey_exp").toString(), 3);
 
-            RSA *publickey = generate_rsa_publickey(json_object.value("publickey_mod").toString(), json_object.value("publickey_exp").toString());
-            timestamp = json_object.value("timestamp").toString();
+            RSA *publickey = generate_rsa_publickey(future->value("publickey_mod").toString(), future->value("publickey_exp").toString());
+            timestamp = future->value("timestamp").toString();
 
             if (publickey != NULL)
             {
@@ -409,11 +402,11 @@ void Login::process_rsa(QNetworkReply *reply)
     }
     else
     {
-        output("Network Error: " + reply->errorString(), 1);
+        output("Network Error: " + future->error_string(), 1);
         emit unlock_login();
     }
 
-    reply->deleteLater();
+    future->deleteLater();
 }
 
 /**
@@ -421,7 +414,7 @@ void Login::process_rsa(QNetworkReply *reply)
  *      Query the server for the user authentication and triggers the process_login slot
  * @date
  *      Created:  Filipe, 5 Feb 2014
- *      Modified: Filipe, 12 Feb 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
 void Login::request_login()
 {
@@ -439,10 +432,12 @@ void Login::request_login()
     parameters.addQueryItem("remember_login", remember_login  ? "true" : "false");
     parameters.addQueryItem("l", "english");   
 
-    disconnect(network_manager, SIGNAL(finished(QNetworkReply*)), this, NULL);
-    connect(network_manager, SIGNAL(finished(QNetworkReply*)), this, SLOT(process_login(QNetworkReply*)));
-
-    network_manager->postHTTP(url_dologin, parameters);
+    NetworkFuture *future = network_manager->postHTTP_async(url_dologin, parameters);
+    future->stream(QStringList() << "success" << "login_complete" << "message"
+                                 << "transfer_url" << "transfer_parameters"
+                                 << "captcha_needed" << "captcha_gid"
+                                 << "emailauth_needed" << "emailsteamid" << "emaildomain");
+    future->then(this, SLOT(process_login(NetworkFuture*)));
 }
 
 /**
@@ -451,27 +446,24 @@ void Login::request_login()
  * @remarks
  *      The transfer, unlike all the other POST and GET methods, is built only with the parameters
  *      that the server returns, here we emulate the same behavior as the login.js in the steam page.
- * @param reply
+ * @param future
  *      The result from the user authentication request.
  * @date
  *      Created:  Filipe, 9 Jan 2014
- *      Modified: Filipe, 15 Apr 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
-void Login::process_login(QNetworkReply *reply)
+void Login::process_login(NetworkFuture *future)
 {
-    if(reply->error() == QNetworkReply::NoError)
+    if(future->error() == QNetworkReply::NoError)
     {
-        QByteArray buffer = reply->read(reply->bytesAvailable());
-        QJsonObject json_object = QJsonDocument::fromJson(buffer).object();
-
-        if(json_object.value("success").toBool() && json_object.value("login_complete").toBool())
+        if(future->value("success").toBool() && future->value("login_complete").toBool())
         {
             //Unscape URL
-            QUrl transfer_url = json_object.value("transfer_url").toString().replace("\\", "");
+            QUrl transfer_url = future->value("transfer_url").toString().replace("\\", "");
 
             //Build parameters
             QHash<QString, QString> transfer_parameters;
-            QJsonObject transfer_parameters_object = json_object.value("transfer_parameters").toObject();
+            QJsonObject transfer_parameters_object = future->value("transfer_parameters").toObject();
             QStringList transfer_parameters_keys = transfer_parameters_object.keys();
 
             for(int i = 0; i < transfer_parameters_keys.size(); i++)
@@ -490,17 +482,17 @@ void Login::process_login(QNetworkReply *reply)
         }
         else
         {
-            output(json_object.value("message").toString(), 1);
+            output(future->value("message").toString(), 1);
 
-            if(json_object.value("captcha_needed").toBool())
+            if(future->value("captcha_needed").toBool())
             {
-                captcha_id = json_object.value("captcha_gid").toString();
+                captcha_id = future->value("captcha_gid").toString();
                 request_captcha();
             }
-            else if(json_object.value("emailauth_needed").toBool())
+            else if(future->value("emailauth_needed").toBool())
             {
-                guard_email = json_object.value("emailsteamid").toString();
-                output("Type the code sent to your email at " + json_object.value("emaildomain").toString(), 1);
+                guard_email = future->value("emailsteamid").toString();
+                output("Type the code sent to your email at " + future->value("emaildomain").toString(), 1);
                 emit steamguard_mode();
                 emit unlock_login();
             }
@@ -512,11 +504,11 @@ void Login::process_login(QNetworkReply *reply)
     }
     else
     {
-        output("Network Error: " + reply->errorString(), 1);
+        output("Network Error: " + future->error_string(), 1);
         emit unlock_login();
     }
 
-    reply->deleteLater();
+    future->deleteLater();
 }
 
 /**
@@ -535,7 +527,7 @@ void Login::process_login(QNetworkReply *reply)
  *      There is no need to heap alocate this data because it is just used to pull the cookies from the server.
  * @date
  *      Created:  Filipe, 16 Feb 2014
- *      Modified: Filipe, 15 Apr 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
 void Login::request_transfer(const QUrl &transfer_url, const QHash<QString, QString> &transfer_parameters)
 {
@@ -549,35 +541,32 @@ void Login::request_transfer(const QUrl &transfer_url, const QHash<QString, QStr
         parameters.addQueryItem(i.key(), i.value());
     }
 
-    disconnect(network_manager, SIGNAL(finished(QNetworkReply*)), this, NULL);
-    connect(network_manager, SIGNAL(finished(QNetworkReply*)), this, SLOT(process_transfer(QNetworkReply*)));
-
-    network_manager->postHTTP(transfer_url, parameters);
+    network_manager->postHTTP_async(transfer_url, parameters)->then(this, SLOT(process_transfer(NetworkFuture*)));
 }
 
 /**
  * @brief Login::process_transfer
  *      Checks if the login was successfully transferred to the community page.
- * @param reply
+ * @param future
  *      The result from the login transfer request.
  * @date
  *      Created:  Filipe, 16 Jan 2014
- *      Modified: Filipe, 7 Mar 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
-void Login::process_transfer(QNetworkReply *reply)
+void Login::process_transfer(NetworkFuture *future)
 {
-    if(reply->error() == QNetworkReply::NoError)
+    if(future->error() == QNetworkReply::NoError)
     {
         state = cookies;
         process_state();
     }
     else
     {
-        output("Network Error: " + reply->errorString(), 1);
+        output("Network Error: " + future->error_string(), 1);
         emit unlock_login();
     }
 
-    reply->deleteLater();
+    future->deleteLater();
 }
 
 /**
@@ -585,7 +574,7 @@ void Login::process_transfer(QNetworkReply *reply)
  *      Query the server for the captcha image with GET. Then triggers the process_captcha slot.
  * @date
  *      Created:  Filipe, 5 Feb 2014
- *      Modified: Filipe, 12 Feb 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
 void Login::request_captcha()
 {
@@ -594,26 +583,23 @@ void Login::request_captcha()
     QUrlQuery parameters;
     parameters.addQueryItem("gid", captcha_id);
 
-    disconnect(network_manager, SIGNAL(finished(QNetworkReply*)), this, NULL);
-    connect(network_manager, SIGNAL(finished(QNetworkReply*)), this, SLOT(process_captcha(QNetworkReply*)));
-
-    network_manager->getHTTP(url_captcha, parameters);
+    network_manager->getHTTP_async(url_captcha, parameters)->then(this, SLOT(process_captcha(NetworkFuture*)));
 }
 
 /**
  * @brief Login::process_captcha
  *      Processes the image data and sets the captcha mode with the image to the UI.
- * @param reply
+ * @param future
  *      The result from the captcha request.
  * @date
  *      Created:  Filipe, 20 Jan 2014
- *      Modified: Filipe, 5 Feb 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
-void Login::process_captcha(QNetworkReply *reply)
+void Login::process_captcha(NetworkFuture *future)
 {
-    if(reply->error() == QNetworkReply::NoError)
+    if(future->error() == QNetworkReply::NoError)
     {
-        QByteArray buffer = reply->read(reply->bytesAvailable());
+        QByteArray buffer = future->body();
 
         QPixmap captcha;
         captcha.loadFromData(buffer);
@@ -623,11 +609,11 @@ void Login::process_captcha(QNetworkReply *reply)
     }
     else
     {
-        output("Network Error: " + reply->errorString(), 1);
+        output("Network Error: " + future->error_string(), 1);
         emit unlock_login();
     }
 
-    reply->deleteLater();
+    future->deleteLater();
 }
 
 /**
@@ -636,30 +622,28 @@ void Login::process_captcha(QNetworkReply *reply)
  *      The returned page is also used to parse some account information.
  * @date
  *      Created:  Filipe, 20 Feb 2014
- *      Modified: Filipe, 15 Apr 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
 void Login::request_cookies()
 {
-    disconnect(network_manager, SIGNAL(finished(QNetworkReply*)), this, NULL);
-    connect(network_manager, SIGNAL(finished(QNetworkReply*)), this, SLOT(process_cookies(QNetworkReply*)));
-
-    replys.clear();
-    for(int i = 0; i < 4; i++)
-    {
-        replys.append(NULL);
-    }
+    futures.clear();
 
     output("Requesting account information...", 2);
-    replys[0] = network_manager->getHTTP(url_account);
+    futures.append(network_manager->getHTTP_async(url_account));
 
     output("Requesting steampowered cookies...", 2);
-    replys[1] = network_manager->getHTTP(url_store);
+    futures.append(network_manager->getHTTP_async(url_store));
 
     output("Requesting steamcommunity cookies...", 2);
-    replys[2] = network_manager->getHTTP(url_community);
+    futures.append(network_manager->getHTTP_async(url_community));
 
     output("Requesting eligibilitycheck cookies...", 2);
-    replys[3] = network_manager->getHTTP(url_eligibility);
+    futures.append(network_manager->getHTTP_async(url_eligibility));
+
+    for(int i = 0; i < futures.size(); i++)
+    {
+        futures.at(i)->then(this, SLOT(process_cookies(NetworkFuture*)));
+    }
 }
 
 /**
@@ -667,26 +651,26 @@ void Login::request_cookies()
  *      This is a multi-request, it is accessed the number of times that request_cookies requests.
  *      It verifys if the pages were loaded correctly, and uses the information to fillin the account data.
  *      If no errors ocurred, the last call advances the state and deletes all replys.
- * @param reply
+ * @param future
  *      The result from the cookie request.
  * @date
  *      Created:  Filipe, 20 Feb 2014
- *      Modified: Filipe, 15 Apr 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
-void Login::process_cookies(QNetworkReply *reply)
+void Login::process_cookies(NetworkFuture *future)
 {
     bool clear = false;
 
     int counter = 0;
     int counter_error = 0;
-    int replys_size = replys.size();
+    int futures_size = futures.size();
 
     //Find out if all replys already finished
-    for(int i = 0; i < replys_size; i++)
+    for(int i = 0; i < futures_size; i++)
     {
-        if(replys.at(i)->isFinished())
+        if(futures.at(i)->is_finished())
         {
-            if(replys.at(i)->error() == QNetworkReply::NoError)
+            if(futures.at(i)->error() == QNetworkReply::NoError)
             {
                 counter++;
             }
@@ -698,28 +682,28 @@ void Login::process_cookies(QNetworkReply *reply)
     }
 
     //Process replys
-    if(reply->error() == QNetworkReply::NoError)
+    if(future->error() == QNetworkReply::NoError)
     {
-        output("Got reply from: " + reply->url().toDisplayString(), 2);
+        output("Got reply from: " + future->url().toDisplayString(), 2);
 
-        if(reply == replys[0])
+        if(future == futures.at(0))
         {
-            account_page = reply->read(reply->bytesAvailable());
+            account_page = future->body();
         }
     }
     else
     {
-        output("Network Error: " + reply->errorString(), 1);
+        output("Network Error: " + future->error_string(), 1);
     }
 
     //If all replys arrived
-    if(counter == replys_size)
+    if(counter == futures_size)
     {
         state = profile;
         process_state();
         clear = true;
     }
-    else if((counter + counter_error) == replys_size)
+    else if((counter + counter_error) == futures_size)
     {
         emit unlock_login();
         clear = true;
@@ -728,11 +712,11 @@ void Login::process_cookies(QNetworkReply *reply)
     //Clear all replys
     if(clear)
     {
-        for(int i = 0; i < replys_size; i++)
+        for(int i = 0; i < futures_size; i++)
         {
-            replys.at(i)->deleteLater();
+            futures.at(i)->deleteLater();
         }
-        replys.clear();
+        futures.clear();
     }
 }
 
@@ -742,7 +726,7 @@ void Login::process_cookies(QNetworkReply *reply)
  *      The account_page is set by the last state.
  * @date
  *      Created:  Filipe, 26 Apr 2014
- *      Modified: Filipe, 26 Apr 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
 void Login::request_profile()
 {
@@ -767,10 +751,7 @@ void Login::request_profile()
         QUrlQuery parameters;
         parameters.addQueryItem("xml", "1");
 
-        disconnect(network_manager, SIGNAL(finished(QNetworkReply*)), this, NULL);
-        connect(network_manager, SIGNAL(finished(QNetworkReply*)), this, SLOT(process_profile(QNetworkReply*)));
-
-        network_manager->getHTTP(QUrl(url_profile), parameters);
+        network_manager->getHTTP_async(QUrl(url_profile), parameters)->then(this, SLOT(process_profile(NetworkFuture*)));
     }
     else
     {
@@ -786,15 +767,15 @@ void Login::request_profile()
  * @remarks
  *      If an error occurs while parsing, atEnd() and hasError() return true,
  *      so xml.error() == QXmlStreamReader::NoError is not needed.
- * @param reply
+ * @param future
  *      The profile page in xml.
  * @date
  *      Created:  Filipe, 27 Apr 2014
- *      Modified: Filipe, 27 Apr 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
-void Login::process_profile(QNetworkReply *reply)
+void Login::process_profile(NetworkFuture *future)
 {
-    if(reply->error() == QNetworkReply::NoError)
+    if(future->error() == QNetworkReply::NoError)
     {
         QString url_profile = "";
 
@@ -827,7 +808,7 @@ void Login::process_profile(QNetworkReply *reply)
         QString steamID = "";
         QString avatar = "";
 
-        QXmlStreamReader xml(reply->read(reply->bytesAvailable()));
+        QXmlStreamReader xml(future->body());
 
         while (!xml.atEnd()) //Include error handling
         {
@@ -882,11 +863,11 @@ void Login::process_profile(QNetworkReply *reply)
     }
     else
     {
-        output("Network Error: " + reply->errorString(), 1);
+        output("Network Error: " + future->error_string(), 1);
         emit unlock_login();
     }
 
-    reply->deleteLater();
+    future->deleteLater();
 }
 
 /**
@@ -121,18 +121,18 @@ private_members:
 
 private_data_members:
     QByteArray account_page;
-    QList<QNetworkReply*> replys;
+    QList<NetworkFuture*> futures;
     NetworkManager *network_manager;
 
 private slots:
-    void process_persistent(QNetworkReply *reply);
-    void process_cookies(QNetworkReply *reply);
-    void process_rsa(QNetworkReply *reply);
-    void process_login(QNetworkReply *reply);
-    void process_captcha(QNetworkReply *reply);
-    void process_transfer(QNetworkReply *reply);
-    void process_profile(QNetworkReply *reply);
-    void process_logout(QNetworkReply *reply);
+    void process_persistent(NetworkFuture *future);
+    void process_cookies(NetworkFuture *future);
+    void process_rsa(NetworkFuture *future);
+    void process_login(NetworkFuture *future);
+    void process_captcha(NetworkFuture *future);
+    void process_transfer(NetworkFuture *future);
+    void process_profile(NetworkFuture *future);
+    void process_logout(NetworkFuture *future);
 
 signals:
     void console(const QString &message);
@@ -31,19 +31,64 @@ void debug_messages_handler(QtMsgType type, const QMessageLogContext &context, c
  *      Command line argument vector.
  * @return
  *      0 = Success
+ * @remarks
+ *      The test overrides (STEAMKALIX_ENDPOINT and STEAMKALIX_HOSTS) are only read with the --testing flag,
+ *      they send the Steam requests, credentials included, elsewhere. A warning is shown while they are active.
  * @date
  *      Created:  Filipe, 29 Dez 2013
- *      Modified: Filipe, 29 Dez 2013
+ *      Modified: Filipe, 16 Oct 2026
  */
 int main(int argc, char *argv[])
 {
     qInstallMessageHandler(debug_messages_handler);
 
     QApplication application(argc, argv);
+
+    QStringList overrides;
+
+    if(application.arguments().contains("--testing"))
+    {
+        //Test servers, e.g. STEAMKALIX_ENDPOINT=http://127.0.0.1:8080 for the MockMarket
+        if(qEnvironmentVariableIsSet("STEAMKALIX_ENDPOINT"))
+        {
+            NetworkManager::set_endpoint(QUrl(QString::fromLocal8Bit(qgetenv("STEAMKALIX_ENDPOINT"))));
+            overrides << "endpoint " + QString::fromLocal8Bit(qgetenv("STEAMKALIX_ENDPOINT"));
+        }
+
+        //Fixed addresses of the proxys, e.g. STEAMKALIX_HOSTS=proxy1.local=127.0.0.1,proxy2.local=127.0.0.2
+        if(qEnvironmentVariableIsSet("STEAMKALIX_HOSTS"))
+        {
+            QStringList hosts = QString::fromLocal8Bit(qgetenv("STEAMKALIX_HOSTS")).split(',', QString::SkipEmptyParts);
+
+            for(int i = 0; i < hosts.size(); i++)
+            {
+                DnsCache::set_host(hosts.at(i).section('=', 0, 0).trimmed(), QHostAddress(hosts.at(i).section('=', 1).trimmed()));
+            }
+
+            overrides << "hosts " + QString::fromLocal8Bit(qgetenv("STEAMKALIX_HOSTS"));
+        }
+    }
+    else if(qEnvironmentVariableIsSet("STEAMKALIX_ENDPOINT") || qEnvironmentVariableIsSet("STEAMKALIX_HOSTS"))
+    {
+        qWarning("STEAMKALIX_ENDPOINT and STEAMKALIX_HOSTS are ignored without --testing.");
+    }
+
     SteamKalix steamkalix;
+
+    if(!overrides.isEmpty())
+    {
+        qWarning("Testing, the Steam requests are redirected: %s", qPrintable(overrides.join(", ")));
+        steamkalix.setWindowTitle(steamkalix.windowTitle() + " [TESTING: " + overrides.join(", ") + "]");
+    }
+
     steamkalix.show();
 
-    return application.exec();
+    int result = application.exec();
+
+    //The cookies saved in the background are written before exiting
+    CookieJournal::wait();
+
+    return result;
 }
 
 /**
@@ -118,6 +163,7 @@ void debug_messages_handler(QtMsgType type, const QMessageLogContext &context, c
  * +TODO v0.4: Review component tooltips.
  * +TODO v0.4: Disable unused options.
  * +TODO v0.4: Replace QList<QTableWidgetItem *> for QModelIndexList method.
+ * +TODO v0.5: Listing timeout has an Auto option.
  * -TODO v0.X: Change listing table (ID, Short URL, Status, Main ACC).
  * -TODO v0.X: Currency, language and country options. (They can be made from: Cookies, profile or change the page cookies to /market/.)
  * -TODO v0.X: Proxy organize.
@@ -149,7 +195,9 @@ void debug_messages_handler(QtMsgType type, const QMessageLogContext &context, c
  * +TODO v0.3: Fixed "Empty" to pull proxys.
  * +TODO v0.3: Logout for multiple users.
  * +TODO v0.4: Removed "Empty" exception.
- * -TODO v0.X: Login new logic, use single finnish method. (Avoids connects/disconnects).
+ * +TODO v0.5: Login new logic, each request has its own continuation. (Avoids connects/disconnects).
+ * +TODO v0.5: RSA and login replies are parsed while they arrive (JsonStream).
+ * +TODO v0.5: Resolves the hosts of the network while the login runs.
  * -TODO v0.X: BUG: Logout if queried from diferent IP. Make login checks.
  * -TODO v0.X: BUG: Potencial session problems with multilogins.
  * -TODO v0.X: Emulate the timezoneOffset cookie. This cookie does not show in the trafic analyser because it is set by the JS, function: setTimezoneCookies
@@ -163,12 +211,17 @@ void debug_messages_handler(QtMsgType type, const QMessageLogContext &context, c
  * +TODO v0.1: Load method optionally cleans cookies.
  * +TODO v0.1: Print method now uses HTML paragraphs instead of '\n'
  * +TODO v0.4: Count number of active cookies.
+ * +TODO v0.5: Cookies indexed by domain, lookups visit only the domains of the host, count is O(1) and reads do not copy.
+ * +TODO v0.5: Cookies kept in an implicitly shared CookieSet, lookups memoized by URL.
+ * +TODO v0.5: Cookies stored in an append-only binary CookieJournal, a save writes only the changes (cookies.dat).
+ * +TODO v0.5: Changes tracked and saved in the background after a flush interval (OptionsTab/CookieFlush), changes in between are saved together.
  * -TODO v0.X: Crypt cookies in file (Only values, so I can use QSettings).
  *
  * SettingsManager:
  * +TODO v0.1: Create SettingsManager class to abstract file interaction.
  * +TODO v0.1: Documentation.
  * +TODO v0.1: Logging function.
+ * +TODO v0.5: File parsed once into an in-memory store behind a reader-writer lock, changes written together (write-behind, flush).
  *
  * NetworkManager:
  * +TODO v0.1: Network manager created and reimplemented.
@@ -195,10 +248,91 @@ void debug_messages_handler(QtMsgType type, const QMessageLogContext &context, c
  * +TODO v0.4: No cookies support with new constructor and load parameter.
  * +TODO v0.4: Network print shows "No cookies".
  * +TODO v0.4: Overall organization.
+ * +TODO v0.5: Per-route access managers, switching routes keeps the connections alive.
+ * +TODO v0.5: TLS sessions are resumed from the SessionCache.
+ * +TODO v0.5: Users registry is a hash with copy-on-write snapshots, lookups are lock-free.
+ * +TODO v0.5: Throttle uses an index cursor over a route table, rebuilt by registry generation.
+ * +TODO v0.5: Asynchronous GET and POST returning a NetworkFuture.
+ * +TODO v0.5: Batched GET requests spread over the routes in one pass.
+ * +TODO v0.5: Timeouts are handled by a single TimerWheel per instance.
+ * +TODO v0.5: Latency histogram per route, automatic timeout (p99 x factor, bounded).
+ * +TODO v0.5: Optional coalescing of identical asynchronous GET requests in flight.
+ * +TODO v0.5: Optional response cache, conditional GET requests and 304 served from memory.
+ * +TODO v0.5: Endpoint override to send the Steam requests to a test server (STEAMKALIX_ENDPOINT).
+ * +TODO v0.5: Header profiles built once and selected per request by handle, GET and POST share send_request.
+ * +TODO v0.5: POST with a pre-encoded PostBody, the static fields are not encoded per request.
+ * +TODO v0.5: Phase timing per request (queue, connect, first byte, download), histograms per route.
+ * +TODO v0.5: Queue of the asynchronous requests over the limits, dispatched by the RequestLimiter.
+ * +TODO v0.5: Proxys and Steam hosts resolved at login (resolve_hosts), the routes connect to the proxys by address.
+ * +TODO v0.5: Accept-Encoding set explicitly (gzip, deflate and br when available).
+ * +TODO v0.5: cookiesForUrl reads the CookieSet of the user, no jar is allocated (fixes a leak per call).
+ * +TODO v0.5: Users share their CookieSet with the jars, switching users is a copy-on-write swap.
+ * +TODO v0.5: Endpoint and fixed hosts overrides only with --testing, shown in the window title.
+ * +TODO v0.5: Timed out requests are latency samples at their timeout, the automatic timeout of a slow route grows.
+ * +TODO v0.5: Accept-Encoding only on the NetworkFuture requests, getHTTP and postHTTP keep the transparent decompression.
+ * +TODO v0.5: The queue probes the route table in the limiter and selects only the route that accepts the request.
+ * +TODO v0.5: The access managers of removed routes are deleted once their replies are gone.
+ *
+ * SessionCache:
+ * +TODO v0.5: Process-wide TLS session tickets by host and route, with hit/miss counters.
+ * +TODO v0.5: Tickets by host and proxy, the login and the users share them. Atomic hit/miss counters.
+ *
+ * NetworkFuture:
+ * +TODO v0.5: Per-request result with continuation and cancellation.
+ * +TODO v0.5: Followers share the result of a coalesced request.
+ * +TODO v0.5: Flag for results served from the ResponseCache.
+ * +TODO v0.5: Optional JSON stream, fields are parsed on readyRead without buffering the body.
+ * +TODO v0.5: Body read into a pooled buffer, returned to the BufferPool with the future.
+ * +TODO v0.5: Compressed bodies decoded while they arrive, before the buffer or the JSON stream.
+ * +TODO v0.5: The leader of coalesced requests is aborted when all its followers are cancelled.
+ *
+ * NetworkBatch:
+ * +TODO v0.5: Single completion handle for a batch of futures.
+ *
+ * TimerWheel:
+ * +TODO v0.5: Hierarchical timer wheel, deadlines expire in batch per tick.
+ * +TODO v0.5: Deadlines counted from the clock, a late event loop does not expire new requests early.
+ *
+ * LatencyHistogram:
+ * +TODO v0.5: Log-linear streaming histogram with decaying window.
+ *
+ * ResponseCache:
+ * +TODO v0.5: In-memory shared cache of GET responses, size bound with LRU eviction.
+ * +TODO v0.5: Entries stored expired, every hit is revalidated with the server. Private responses stored per user.
+ *
+ * JsonStream:
+ * +TODO v0.5: Incremental JSON parser that extracts fields by path while the reply arrives.
+ *
+ * PostBody:
+ * +TODO v0.5: Reusable form body, static fields encoded once and variable slots patched per request.
+ *
+ * RequestLimiter:
+ * +TODO v0.5: Per-host and per-route in-flight limits with a token bucket, 429 and 503 honor Retry-After and halve the rate.
+ *
+ * BufferPool:
+ * +TODO v0.5: Pool of reply buffers sized by the observed payload of each page, read without readAll, with hit/miss counters.
+ *
+ * DnsCache:
+ * +TODO v0.5: Hosts resolved ahead of time, addresses kept for a time to live and refreshed in the background.
+ * +TODO v0.5: Fixed addresses for tests (STEAMKALIX_HOSTS).
+ * +TODO v0.5: Instance moved to the thread of the application, failed lookups retried with a backoff.
+ *
+ * StreamDecoder:
+ * +TODO v0.5: Streaming decompression of gzip, deflate (raw or zlib) and brotli bodies, chunk by chunk.
+ *
+ * CookieJournal:
+ * +TODO v0.5: Binary append-only journal of the cookies of all users, compacted when most records are outdated.
+ * +TODO v0.5: Background saves on a single thread, in order (save_later, wait).
+ * +TODO v0.5: An unreadable journal is moved aside and logged, never truncated.
+ *
+ * MockMarket:
+ * +TODO v0.5: Mock of the login and market servers from recorded fixtures, with latency, errors and page sizes.
+ * +TODO v0.5: Deflate bodies when accepted, with body and sent byte counters.
  *
  * ReplyTimeout:
  * +TODO v0.1: Implementation of base functionality.
  * +TODO v0.1: Documentation.
+ * +TODO v0.5: Replaced by the TimerWheel of the NetworkManager.
  *
  * ThreadsManager:
  * +TODO v0.1: Create ThreadManager class base.
@@ -299,6 +433,10 @@ void debug_messages_handler(QtMsgType type, const QMessageLogContext &context, c
  *
  * ListingsManager:
  * +TODO v0.1: Base implementation.
+ * +TODO v0.5: Requests use the NetworkFuture continuations.
+ * +TODO v0.5: Coalescing enabled for the market requests.
+ * +TODO v0.5: Response cache enabled for the market requests.
+ * +TODO v0.5: Limits the polls per host and route, the market answers 429 to bursts.
  * -TODO v0.X: Verify current listings (reprice items), items that failed to put on sale! (Watch out for items that should not be sold like Keys)
  * -TODO v0.X: Send emails with statistics.
  * -TODO v0.X: Crawler for the market, check recent added items?
@@ -0,0 +1,155 @@
+/*
+ * SteamKalix
+ * Copyright (C) 2014 Filipe Carvalho
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "networkbatch.h"
+
+/**
+ * @brief NetworkBatch::NetworkBatch
+ *      Initializes members.
+ * @param parent
+ *      The network manager that made the requests.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+NetworkBatch::NetworkBatch(QObject *parent) :
+    QObject(parent),
+    pending(0),
+    errors(0)
+{
+}
+
+/**
+ * @brief NetworkBatch::add
+ *      Adds the future of a request to the batch and takes the ownership of it.
+ * @param future
+ *      The future of the request.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void NetworkBatch::add(NetworkFuture *future)
+{
+    future->setParent(this);
+    future->then(this, SLOT(future_finished(NetworkFuture*)));
+
+    futures.append(future);
+    pending++;
+}
+
+/**
+ * @brief NetworkBatch::then
+ *      Sets the continuation of the batch.
+ *      It must be set before returning to the event loop, otherwise the result might be missed.
+ * @param receiver
+ *      The object that receives the result.
+ * @param method
+ *      The slot, it must receive a NetworkBatch*. E.g. SLOT(process(NetworkBatch*))
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void NetworkBatch::then(QObject *receiver, const char *method)
+{
+    connect(this, SIGNAL(finished(NetworkBatch*)), receiver, method);
+}
+
+/**
+ * @brief NetworkBatch::cancel
+ *      Aborts all the pending requests of the batch. The continuation will not be called.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void NetworkBatch::cancel()
+{
+    disconnect(this, SIGNAL(finished(NetworkBatch*)), NULL, NULL);
+
+    for(int i = 0; i < futures.size(); i++)
+    {
+        futures.at(i)->cancel();
+    }
+}
+
+/**
+ * @brief NetworkBatch::future_finished
+ *      This slot is received from the continuation of each future.
+ *      When the last request finishes, the continuation of the batch is called.
+ * @param future
+ *      The finished future.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void NetworkBatch::future_finished(NetworkFuture *future)
+{
+    if(future->error() != QNetworkReply::NoError)
+    {
+        errors++;
+    }
+
+    pending--;
+
+    if(pending == 0)
+    {
+        emit finished(this);
+    }
+}
+
+/**
+ * @brief NetworkBatch::finish_empty
+ *      Calls the continuation of a batch without requests.
+ *      It is invoked from the event loop (queued) by the network manager, after the continuation was set.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void NetworkBatch::finish_empty()
+{
+    if(pending == 0)
+    {
+        emit finished(this);
+    }
+}
+
+/**
+ * @brief NetworkBatch::Getters
+ *      The following functions are used to retrive the state and the results of the batch.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+int NetworkBatch::size() const
+{
+    return futures.size();
+}
+
+int NetworkBatch::failed() const
+{
+    return errors;
+}
+
+bool NetworkBatch::is_finished() const
+{
+    return pending == 0;
+}
+
+NetworkFuture* NetworkBatch::future(const int &index) const
+{
+    return futures.value(index, NULL);
+}
@@ -0,0 +1,72 @@
+/*
+ * SteamKalix
+ * Copyright (C) 2014 Filipe Carvalho
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef NETWORKBATCH_H
+#define NETWORKBATCH_H
+
+#include <QObject>
+#include <QList>
+
+#include "defines.h"
+#include "networkfuture.h"
+
+/**
+ * @brief The NetworkBatch class
+ *      This class groups the futures of a batch of requests (see NetworkManager::getHTTP_batch) into a single completion handle.
+ *      The continuation is called once, when every request of the batch has finished.
+ *      The result of each request is read from its future, in the same order of the submission.
+ * @remarks
+ *      The futures belong to the batch, deleting the batch deletes all of them.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+class NetworkBatch : public QObject
+{
+    Q_OBJECT
+
+public_construct:
+    explicit NetworkBatch(QObject *parent = 0);
+
+public_methods:
+    void add(NetworkFuture *future);
+    void then(QObject *receiver, const char *method);
+    void cancel();
+
+    int size() const;
+    int failed() const;
+    bool is_finished() const;
+    NetworkFuture* future(const int &index) const;
+
+private_members:
+    int pending;
+    int errors;
+
+private_data_members:
+    QList<NetworkFuture*> futures;
+
+private slots:
+    void future_finished(NetworkFuture *future);
+    void finish_empty();
+
+signals:
+    void finished(NetworkBatch *batch);
+
+};
+
+#endif // NETWORKBATCH_H
@@ -0,0 +1,386 @@
+/*
+ * SteamKalix
+ * Copyright (C) 2014 Filipe Carvalho
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "networkfuture.h"
+
+/**
+ * @brief NetworkFuture::NetworkFuture
+ *      Initializes members. The reply is set with set_reply.
+ * @param parent
+ *      The network manager that made the request.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+NetworkFuture::NetworkFuture(QObject *parent) :
+    QObject(parent),
+    followers(0),
+    state_finished(false),
+    state_cancelled(false),
+    state_cached(false),
+    reply_error(QNetworkReply::NoError),
+    reply_error_string(""),
+    network_reply(NULL),
+    json_stream(NULL),
+    stream_decoder(NULL),
+    json_parsed(false)
+{
+}
+
+/**
+ * @brief NetworkFuture::~NetworkFuture
+ *      The reply belongs to this object, it is deleted with it.
+ *      The buffers of the reply are returned to the BufferPool.
+ *      A follower deleted before the result stops following, like a cancelled one.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+NetworkFuture::~NetworkFuture()
+{
+    if(!state_finished && !state_cancelled)
+    {
+        unfollow();
+    }
+
+    if(network_reply != NULL)
+    {
+        network_reply->disconnect(this);
+        network_reply->deleteLater();
+
+        BufferPool::release(buffer, buffer_key);
+        BufferPool::release(encoded);
+    }
+
+    delete stream_decoder;
+}
+
+/**
+ * @brief NetworkFuture::set_reply
+ *      Binds the reply of the request to this object.
+ *      The body is read into a buffer of the BufferPool, sized by the previous replies of the same page.
+ * @param new_reply
+ *      The reply from the GET or POST.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void NetworkFuture::set_reply(QNetworkReply *new_reply)
+{
+    network_reply = new_reply;
+    reply_url = network_reply->url();
+    buffer_key = reply_url.host() + reply_url.path();
+    buffer = BufferPool::acquire(buffer_key);
+
+    connect(network_reply, SIGNAL(readyRead()), this, SLOT(reply_ready()));
+    connect(network_reply, SIGNAL(finished()), this, SLOT(reply_finished()));
+}
+
+/**
+ * @brief NetworkFuture::follow
+ *      Binds this object to the result of another future, used when identical requests are coalesced.
+ *      No request is made for this object.
+ * @param leader
+ *      The future of the request in flight.
+ * @remarks
+ *      Cancelling a follower only aborts the request of the leader when no other follower needs it (unfollow).
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void NetworkFuture::follow(NetworkFuture *leader)
+{
+    reply_url = leader->url();
+    leader_future = leader;
+    leader->followers++;
+
+    connect(leader, SIGNAL(finished(NetworkFuture*)), this, SLOT(leader_finished(NetworkFuture*)));
+}
+
+/**
+ * @brief NetworkFuture::stream
+ *      Parses the body as JSON while it arrives, instead of buffering it.
+ *      It must be set before returning to the event loop, like the continuation.
+ * @param fields
+ *      Paths of the values to extract, see JsonStream.
+ * @return
+ *      The parser, its found() signal can be used to decide before the reply finishes.
+ * @remarks
+ *      With a stream, body() and json() are empty, the result is read with value().
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+JsonStream* NetworkFuture::stream(const QStringList &fields)
+{
+    json_stream = new JsonStream(fields, this);
+    return json_stream;
+}
+
+/**
+ * @brief NetworkFuture::then
+ *      Sets the continuation of this request.
+ *      It must be set before returning to the event loop, otherwise the result might be missed.
+ * @param receiver
+ *      The object that receives the result.
+ * @param method
+ *      The slot, it must receive a NetworkFuture*. E.g. SLOT(process(NetworkFuture*))
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void NetworkFuture::then(QObject *receiver, const char *method)
+{
+    connect(this, SIGNAL(finished(NetworkFuture*)), receiver, method);
+}
+
+/**
+ * @brief NetworkFuture::cancel
+ *      Aborts the request. The continuation will not be called, the cancelled() signal is emitted instead.
+ *      This object still has to be deleted by the owner.
+ * @remarks
+ *      A follower aborts the request of its leader only if it was the last follower.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void NetworkFuture::cancel()
+{
+    if(!state_finished && !state_cancelled)
+    {
+        state_cancelled = true;
+        reply_error = QNetworkReply::OperationCanceledError;
+
+        if(network_reply != NULL)
+        {
+            network_reply->abort();
+        }
+
+        unfollow();
+
+        emit cancelled(this);
+    }
+}
+
+/**
+ * @brief NetworkFuture::unfollow
+ *      Stops following the leader. The leader is cancelled when it has no followers left.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void NetworkFuture::unfollow()
+{
+    if(!leader_future.isNull())
+    {
+        leader_future->disconnect(this);
+        leader_future->followers--;
+
+        if(leader_future->followers == 0)
+        {
+            leader_future->cancel();
+        }
+
+        leader_future = NULL;
+    }
+}
+
+/**
+ * @brief NetworkFuture::reply_ready
+ *      This slot is received from the readyRead() signal of the reply.
+ *      The body is read while it arrives, into the buffer or the JSON stream.
+ *      The data is copied into the pooled buffer, no array is allocated per chunk.
+ *      With a stream, the buffer only holds the current chunk and keeps its capacity for the next one.
+ *      A compressed chunk is read into its own buffer and decoded into the buffer, see StreamDecoder.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void NetworkFuture::reply_ready()
+{
+    //The headers are known on the first chunk
+    if(stream_decoder == NULL && StreamDecoder::is_supported(network_reply->rawHeader("Content-Encoding")))
+    {
+        stream_decoder = new StreamDecoder(network_reply->rawHeader("Content-Encoding"));
+        encoded = BufferPool::acquire();
+    }
+
+    if(stream_decoder != NULL)
+    {
+        BufferPool::read(network_reply, encoded);
+        stream_decoder->decode(encoded, buffer);
+        encoded.resize(0);
+    }
+    else
+    {
+        BufferPool::read(network_reply, buffer);
+    }
+
+    if(json_stream != NULL)
+    {
+        json_stream->append(buffer);
+        buffer.resize(0);
+    }
+}
+
+/**
+ * @brief NetworkFuture::reply_finished
+ *      This slot is received from the finished() signal of the reply.
+ *      Stores the result and calls the continuation. A body that fails to decompress is a protocol failure.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void NetworkFuture::reply_finished()
+{
+    if(network_reply->isReadable())
+    {
+        reply_ready();
+    }
+
+    if(json_stream != NULL)
+    {
+        json_stream->finish();
+    }
+
+    state_finished = true;
+    state_cached = network_reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool();
+
+    if(!state_cancelled)
+    {
+        reply_error = network_reply->error();
+        reply_error_string = network_reply->errorString();
+
+        if(reply_error == QNetworkReply::NoError && stream_decoder != NULL && stream_decoder->has_error())
+        {
+            reply_error = QNetworkReply::ProtocolFailure;
+            reply_error_string = "The body could not be decompressed.";
+        }
+
+        emit finished(this);
+    }
+}
+
+/**
+ * @brief NetworkFuture::leader_finished
+ *      This slot is received from the finished() signal of the leader.
+ *      Copies the result, including the URL, and calls the continuation.
+ * @param leader
+ *      The future of the coalesced request.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void NetworkFuture::leader_finished(NetworkFuture *leader)
+{
+    if(json_stream != NULL)
+    {
+        json_stream->append(leader->body());
+        json_stream->finish();
+    }
+    else
+    {
+        buffer = leader->body();
+    }
+
+    //The leader might have been queued when this object started following, without a URL
+    reply_url = leader->url();
+    state_finished = true;
+    state_cached = leader->is_cached();
+
+    if(!state_cancelled)
+    {
+        reply_error = leader->error();
+        reply_error_string = leader->error_string();
+
+        emit finished(this);
+    }
+}
+
+/**
+ * @brief NetworkFuture::Getters
+ *      The following functions are used to retrive the state and the result of the request.
+ * @remarks
+ *      json() parses the body on the first call, the following calls return the same object.
+ *      value() returns a field extracted by the stream, undefined without a stream.
+ *      is_cached() is true when the server answered 304 and the body came from the ResponseCache,
+ *      the page did not change since the last request and does not need to be processed again.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+bool NetworkFuture::is_finished() const
+{
+    return state_finished;
+}
+
+bool NetworkFuture::is_cancelled() const
+{
+    return state_cancelled;
+}
+
+bool NetworkFuture::is_cached() const
+{
+    return state_cached;
+}
+
+QNetworkReply::NetworkError NetworkFuture::error() const
+{
+    return reply_error;
+}
+
+QString NetworkFuture::error_string() const
+{
+    return reply_error_string;
+}
+
+QUrl NetworkFuture::url() const
+{
+    return reply_url;
+}
+
+QByteArray NetworkFuture::body() const
+{
+    return buffer;
+}
+
+QJsonObject NetworkFuture::json() const
+{
+    if(!json_parsed)
+    {
+        json_object = QJsonDocument::fromJson(buffer).object();
+        json_parsed = true;
+    }
+
+    return json_object;
+}
+
+QJsonValue NetworkFuture::value(const QString &field) const
+{
+    if(json_stream == NULL)
+    {
+        return QJsonValue(QJsonValue::Undefined);
+    }
+
+    return json_stream->value(field);
+}
+
+QNetworkReply* NetworkFuture::reply() const
+{
+    return network_reply;
+}
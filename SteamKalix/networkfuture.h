@@ -0,0 +1,115 @@
+/*
+ * SteamKalix
+ * Copyright (C) 2014 Filipe Carvalho
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef NETWORKFUTURE_H
+#define NETWORKFUTURE_H
+
+#include <QObject>
+#include <QNetworkReply>
+#include <QPointer>
+#include <QJsonObject>
+#include <QJsonDocument>
+
+#include "defines.h"
+#include "jsonstream.h"
+#include "bufferpool.h"
+#include "streamdecoder.h"
+
+/**
+ * @brief The NetworkFuture class
+ *      This class carries the result of a single request made with the asynchronous API of the NetworkManager.
+ *      The body is read while it arrives and the continuation is connected to this request only,
+ *      so many requests can be in flight without a central finished() slot that has to find out which reply it got.
+ * @remarks Path of execution
+ *      Request with getHTTP_async or postHTTP_async.
+ *      Set the continuation with then(). (Before returning to the event loop)
+ *      The continuation receives this object, reads the result and calls deleteLater().
+ *      A cancelled request never calls the continuation.
+ * @remarks Streaming
+ *      With stream(), the body is not buffered. It is parsed while it arrives and only the fields are kept (value).
+ *      Compressed bodies (gzip, deflate, br) are decoded chunk by chunk before the buffer or the stream.
+ * @remarks Coalescing
+ *      A future can follow another one instead of having a reply (follow). It receives a copy of the result
+ *      of the leader, the body is implicitly shared. Followers have no reply.
+ *      The leader counts its followers, it is cancelled when the last one is cancelled or deleted.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+class NetworkFuture : public QObject
+{
+    Q_OBJECT
+
+public_construct:
+    explicit NetworkFuture(QObject *parent = 0);
+    ~NetworkFuture();
+
+public_methods:
+    void set_reply(QNetworkReply *new_reply);
+    void follow(NetworkFuture *leader);
+    JsonStream* stream(const QStringList &fields);
+    void then(QObject *receiver, const char *method);
+    void cancel();
+
+    bool is_finished() const;
+    bool is_cancelled() const;
+    bool is_cached() const;
+
+    QNetworkReply::NetworkError error() const;
+    QString error_string() const;
+    QUrl url() const;
+    QByteArray body() const;
+    QJsonObject json() const;
+    QJsonValue value(const QString &field) const;
+    QNetworkReply* reply() const;
+
+private_methods:
+    void unfollow();
+
+private_members:
+    int followers;
+    bool state_finished;
+    bool state_cancelled;
+    bool state_cached;
+    QNetworkReply::NetworkError reply_error;
+    QString reply_error_string;
+    QUrl reply_url;
+
+private_data_members:
+    QNetworkReply *network_reply;
+    QPointer<NetworkFuture> leader_future;
+    JsonStream *json_stream;
+    StreamDecoder *stream_decoder;
+    QByteArray buffer;
+    QByteArray encoded;
+    QString buffer_key;
+    mutable QJsonObject json_object;
+    mutable bool json_parsed;
+
+private slots:
+    void reply_ready();
+    void reply_finished();
+    void leader_finished(NetworkFuture *leader);
+
+signals:
+    void finished(NetworkFuture *future);
+    void cancelled(NetworkFuture *future);
+
+};
+
+#endif // NETWORKFUTURE_H
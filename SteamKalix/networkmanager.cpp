@@ -20,19 +20,21 @@
 
 /**
  * @brief NetworkManager::user_settings
- * @brief NetworkManager::request_settings
- * @brief NetworkManager::proxy_settings
- * @brief NetworkManager::cookies_settings
+ * @brief NetworkManager::settings_generation
  *      Definition of static members at file scope.
+ * @remarks
+ *      The registry is only changed while holding the mutex, and every change increments the generation.
+ *      Instances keep an implicitly shared snapshot of the registry and only lock to refresh it when the generation changes.
  * @date
  *      Created:  Filipe, 24 Mar 2014
- *      Modified: Filipe, 3 Apr 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
-QList<QString> NetworkManager::user_settings;
-QList<QNetworkRequest> NetworkManager::request_settings;
-QList<QList<QNetworkProxy> > NetworkManager::proxy_settings;
-QList<QList<QNetworkCookie> > NetworkManager::cookies_settings;
+QHash<QString, NetworkManager::UserSettings> NetworkManager::user_settings;
+QAtomicInt NetworkManager::settings_generation(1);
 QMutex NetworkManager::mutex;
+const int NetworkManager::timeout_auto;
+const int NetworkManager::profile_default;
+QUrl NetworkManager::endpoint;
 
 /**
  * @brief NetworkManager::NetworkManager
@@ -41,25 +43,62 @@ QMutex NetworkManager::mutex;
  *      either just load one. Or an array of accounts with multiple proxys.
  * @remarks
  *      setParent, the initialization list cannot be used, this is a indirect base ( : QObject(parent)).
+ *      The timer wheel is shared by all the requests of this instance, it is destroyed with it.
+ *      The dispatch timer wakes the queue of the limiter when a host accepts requests again.
+ *      The automatic timeout defaults to p99 x 1.5, between 1 and 30 seconds.
  *      The object QNetworkAccessManager will take ownership when setCookieJar is called, no need to destroy.
  * @date
  *      Created:  Filipe, 24 Mar 2014
- *      Modified: Filipe, 3 Sep 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
 NetworkManager::NetworkManager(QObject *parent) :
+    coalescing(false),
+    caching(false),
+    coalesced_count(0),
+    timeout_factor(1.5),
+    timeout_minimum(1000),
+    timeout_maximum(30000),
     current_manager(""),
-    cookies_manager(new PersistentCookieJar())
+    cookies_manager(new PersistentCookieJar()),
+    timer_wheel(new TimerWheel(10, this)),
+    route_current(NULL),
+    dispatch_timer(new QTimer(this)),
+    route_index(0),
+    route_user(-1),
+    routes_generation(0),
+    dns_generation(0),
+    snapshot_generation(0)
 {
     setParent(parent);
     setCookieJar(cookies_manager);
+    route_clock.start();
+    dispatch_timer->setSingleShot(true);
+    connect(dispatch_timer, SIGNAL(timeout()), this, SLOT(dispatch_requests()));
 }
 
 NetworkManager::NetworkManager(QString user, QObject *parent) :
+    coalescing(false),
+    caching(false),
+    coalesced_count(0),
+    timeout_factor(1.5),
+    timeout_minimum(1000),
+    timeout_maximum(30000),
     current_manager(""),
-    cookies_manager(new PersistentCookieJar())
+    cookies_manager(new PersistentCookieJar()),
+    timer_wheel(new TimerWheel(10, this)),
+    route_current(NULL),
+    dispatch_timer(new QTimer(this)),
+    route_index(0),
+    route_user(-1),
+    routes_generation(0),
+    dns_generation(0),
+    snapshot_generation(0)
 {
     setParent(parent);
     setCookieJar(cookies_manager);
+    route_clock.start();
+    dispatch_timer->setSingleShot(true);
+    connect(dispatch_timer, SIGNAL(timeout()), this, SLOT(dispatch_requests()));
 
     if(!user.isEmpty())
     {
@@ -69,11 +108,28 @@ NetworkManager::NetworkManager(QString user, QObject *parent) :
 }
 
 NetworkManager::NetworkManager(QStringList users, QObject *parent) :
+    coalescing(false),
+    caching(false),
+    coalesced_count(0),
+    timeout_factor(1.5),
+    timeout_minimum(1000),
+    timeout_maximum(30000),
     current_manager(""),
-    cookies_manager(new PersistentCookieJar())
+    cookies_manager(new PersistentCookieJar()),
+    timer_wheel(new TimerWheel(10, this)),
+    route_current(NULL),
+    dispatch_timer(new QTimer(this)),
+    route_index(0),
+    route_user(-1),
+    routes_generation(0),
+    dns_generation(0),
+    snapshot_generation(0)
 {
     setParent(parent);
     setCookieJar(cookies_manager);
+    route_clock.start();
+    dispatch_timer->setSingleShot(true);
+    connect(dispatch_timer, SIGNAL(timeout()), this, SLOT(dispatch_requests()));
 
     if(!users.isEmpty())
     {        
@@ -83,11 +139,28 @@ NetworkManager::NetworkManager(QStringList users, QObject *parent) :
 }
 
 NetworkManager::NetworkManager(QStringList users, bool load_cookies, QObject *parent) :
+    coalescing(false),
+    caching(false),
+    coalesced_count(0),
+    timeout_factor(1.5),
+    timeout_minimum(1000),
+    timeout_maximum(30000),
     current_manager(""),
-    cookies_manager(new PersistentCookieJar())
+    cookies_manager(new PersistentCookieJar()),
+    timer_wheel(new TimerWheel(10, this)),
+    route_current(NULL),
+    dispatch_timer(new QTimer(this)),
+    route_index(0),
+    route_user(-1),
+    routes_generation(0),
+    dns_generation(0),
+    snapshot_generation(0)
 {
     setParent(parent);
     setCookieJar(cookies_manager);
+    route_clock.start();
+    dispatch_timer->setSingleShot(true);
+    connect(dispatch_timer, SIGNAL(timeout()), this, SLOT(dispatch_requests()));
 
     if(!users.isEmpty())
     {
@@ -105,33 +178,23 @@ NetworkManager::NetworkManager(QStringList users, bool load_cookies, QObject *pa
  * @param get_parameters
  *      Get parameters to be appended to the URL.
  * @param timeout
- *      Amount of time until de request timeouts.
+ *      Amount of time until de request timeouts. Use timeout_auto to follow the latency of the route.
+ * @param profile
+ *      Handle of the header profile, from add_profile. By default the request of the current user is used.
  * @return
  *      The pointer for the reply of this request.
  * @date
  *      Created:  Filipe, 2 Apr 2014
- *      Modified: Filipe, 3 Apr 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
-QNetworkReply* NetworkManager::getHTTP(QUrl link, const QUrlQuery &get_parameters, const int &timeout)
+QNetworkReply* NetworkManager::getHTTP(QUrl link, const QUrlQuery &get_parameters, const int &timeout, const int &profile)
 {
     if(!users.isEmpty())
     {
         throttle_settings();
     }
 
-    //Add GET parameters
-    link.setQuery(get_parameters);
-    request_manager.setUrl(link);
-
-    //Perform GET request
-    QNetworkReply* reply = get(request_manager);
-
-    if(timeout > 0)
-    {
-        new ReplyTimeout(reply, timeout);
-    }
-
-    return reply;
+    return send_request(QNetworkAccessManager::GetOperation, link, get_parameters, QByteArray(), timeout, profile, false);
 }
 
 /**
@@ -139,6 +202,8 @@ QNetworkReply* NetworkManager::getHTTP(QUrl link, const QUrlQuery &get_parameter
  *      Makes post requests.
  *      Extends the default implementation by adding support for timeouts and managment of the request.
  *      This also simplifys the use of custom headers by backingup the current one, using and then swaping.
+ *      The second version uses a header profile instead, without copying or changing the request.
+ *      The third version sends a pre-encoded body, for the requests where latency matters (buy and sell).
  * @param link
  *      URL to perform request. Parametes will be overwritten.
  * @param post_parameters
@@ -146,14 +211,20 @@ QNetworkReply* NetworkManager::getHTTP(QUrl link, const QUrlQuery &get_parameter
  * @param get_parameters
  *      Get parameters to be appended to the URL.
  * @param timeout
- *      Amount of time until de request timeouts
+ *      Amount of time until de request timeouts. Use timeout_auto to follow the latency of the route.
  * @param temp_settings
  *      Temporary settings, that are applied only for this request.
+ * @param profile
+ *      Handle of the header profile, from add_profile.
+ * @param post_body
+ *      Body with the static fields already encoded, see PostBody. It is not converted again.
  * @return
  *      The pointer for the reply of this request.
+ * @remarks
+ *      Prefer profiles to temporary settings for frequent requests, the settings are walked on every call.
  * @date
  *      Created:  Filipe, 2 Apr 2014
- *      Modified: Filipe, 13 Apr 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
 QNetworkReply* NetworkManager::postHTTP(QUrl link, const QUrlQuery &post_parameters, const QUrlQuery &get_parameters, const int &timeout, const QVariantHash &temp_settings)
 {
@@ -171,27 +242,423 @@ QNetworkReply* NetworkManager::postHTTP(QUrl link, const QUrlQuery &post_paramet
         set_request(temp_settings);
     }
 
+    QNetworkReply* reply = send_request(QNetworkAccessManager::PostOperation, link, get_parameters,
+                                        post_parameters.query().toUtf8(), timeout, profile_default, false);
+
+    //Restore settings
+    if(!temp_settings.isEmpty())
+    {
+        request_manager.swap(original_request);
+    }
+
+    return reply;
+}
+
+QNetworkReply* NetworkManager::postHTTP(QUrl link, const QUrlQuery &post_parameters, const QUrlQuery &get_parameters, const int &timeout, const int &profile)
+{
+    if(!users.isEmpty())
+    {
+        throttle_settings();
+    }
+
+    return send_request(QNetworkAccessManager::PostOperation, link, get_parameters, post_parameters.query().toUtf8(), timeout, profile, false);
+}
+
+QNetworkReply* NetworkManager::postHTTP(QUrl link, const PostBody &post_body, const QUrlQuery &get_parameters, const int &timeout, const int &profile)
+{
+    if(!users.isEmpty())
+    {
+        throttle_settings();
+    }
+
+    return send_request(QNetworkAccessManager::PostOperation, link, get_parameters, post_body.data(), timeout, profile, false);
+}
+
+/**
+ * @brief NetworkManager::send_request
+ *      Makes the get and post requests on the next route.
+ * @param operation
+ *      GetOperation or PostOperation.
+ * @param link
+ *      URL to perform request. Parametes will be overwritten.
+ * @param get_parameters
+ *      Get parameters to be appended to the URL.
+ * @param body
+ *      Body of the post requests, already encoded.
+ * @param timeout
+ *      Amount of time until de request timeouts, or timeout_auto.
+ * @param profile
+ *      Handle of the header profile, or profile_default for the request of the current user.
+ * @param encoded
+ *      True for the requests of a NetworkFuture. Accept-Encoding is set explicitly, so the access manager leaves
+ *      the body compressed and the future decodes it while it arrives (StreamDecoder).
+ *      False for getHTTP and postHTTP, the access manager negotiates and decompresses the body itself.
+ * @return
+ *      The pointer for the reply of this request.
+ * @remarks
+ *      The throttle is made by the caller, before any change to the request.
+ *      A profile is implicitly shared, the only copy is made by setUrl. Both variants of a profile are built once.
+ *      The request of the user only changes when the variant differs from the previous request.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+QNetworkReply* NetworkManager::send_request(const QNetworkAccessManager::Operation &operation, QUrl link, const QUrlQuery &get_parameters, const QByteArray &body, const int &timeout, const int &profile, const bool &encoded)
+{
+    link = redirect(link);
+
     //Add GET parameters
     link.setQuery(get_parameters);
-    request_manager.setUrl(link);
 
-    //Perform POST request
-    QNetworkReply* reply = post(request_manager, post_parameters.query().toUtf8());
+    QNetworkAccessManager *manager = route_manager();
+    QString session = "";
+    QNetworkReply* reply = NULL;
 
-    if(timeout > 0)
+    if(profile >= 0 && profile < profile_settings.size())
     {
-        new ReplyTimeout(reply, timeout);
-    }
+        QNetworkRequest request = profile_request(profile, encoded);
+        request.setUrl(link);
+        session = set_session(request, link);
 
-    //Restore settings
-    if(!temp_settings.isEmpty())
+        reply = (operation == QNetworkAccessManager::PostOperation) ? manager->post(request, body) : manager->get(request);
+    }
+    else
     {
-        request_manager.swap(original_request);
+        request_manager.setUrl(link);
+
+        if(request_manager.hasRawHeader("Accept-Encoding") != encoded)
+        {
+            //An empty value removes the header
+            request_manager.setRawHeader("Accept-Encoding", encoded ? StreamDecoder::accept_encoding() : QByteArray());
+        }
+
+        session = set_session(request_manager, link);
+
+        reply = (operation == QNetworkAccessManager::PostOperation) ? manager->post(request_manager, body) : manager->get(request_manager);
     }
 
+    set_reply(reply, session, timeout);
+
     return reply;
 }
 
+/**
+ * @brief NetworkManager::getHTTP_async
+ * @brief NetworkManager::postHTTP_async
+ *      Makes get and post requests that return a NetworkFuture instead of the reply.
+ *      The parameters are the same as getHTTP and postHTTP.
+ * @remarks
+ *      The result arrives only to the continuation set with NetworkFuture::then,
+ *      the receiver does not need to be connected to the finished() signal of this manager.
+ * @remarks
+ *      With coalescing, a GET identical to one in flight (same URL, query, timeout and profile) is not sent again,
+ *      the future follows the one in flight. Cancelling all the followers aborts the request.
+ * @remarks
+ *      The requests are sent by the queue of the limiter (queue_request). Without limits they are sent immediately,
+ *      otherwise the future gets its reply when the host and a route accept it. Futures cancelled while queued are never sent.
+ * @return
+ *      The future of this request. The receiver of the result must delete it.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+NetworkFuture* NetworkManager::getHTTP_async(const QUrl &link, const QUrlQuery &get_parameters, const int &timeout, const int &profile)
+{
+    NetworkFuture *future = new NetworkFuture(this);
+
+    if(!coalescing)
+    {
+        return queue_request(future, QNetworkAccessManager::GetOperation, link, get_parameters, QByteArray(), timeout, profile);
+    }
+
+    //Attach to the identical request in flight, or make it. The timeout and the profile are part of the request.
+    QUrl coalesced_link(link);
+    coalesced_link.setQuery(get_parameters);
+    QString key = QString::number(profile) + "|" + QString::number(timeout) + "|" + coalesced_link.toString();
+    NetworkFuture *leader = coalesced_requests.value(key, NULL);
+
+    if(leader != NULL)
+    {
+        coalesced_count++;
+    }
+    else
+    {
+        leader = queue_request(new NetworkFuture(this), QNetworkAccessManager::GetOperation, link, get_parameters, QByteArray(), timeout, profile);
+        leader->setProperty("coalesced", key);
+        leader->then(this, SLOT(coalesced_finished(NetworkFuture*)));
+        connect(leader, SIGNAL(cancelled(NetworkFuture*)), this, SLOT(coalesced_finished(NetworkFuture*)));
+        coalesced_requests.insert(key, leader);
+    }
+
+    future->follow(leader);
+
+    return future;
+}
+
+NetworkFuture* NetworkManager::postHTTP_async(const QUrl &link, const QUrlQuery &post_parameters, const QUrlQuery &get_parameters, const int &timeout, const QVariantHash &temp_settings)
+{
+    return queue_request(new NetworkFuture(this), QNetworkAccessManager::PostOperation, link, get_parameters,
+                         post_parameters.query().toUtf8(), timeout, profile_default, temp_settings);
+}
+
+NetworkFuture* NetworkManager::postHTTP_async(const QUrl &link, const QUrlQuery &post_parameters, const QUrlQuery &get_parameters, const int &timeout, const int &profile)
+{
+    return queue_request(new NetworkFuture(this), QNetworkAccessManager::PostOperation, link, get_parameters,
+                         post_parameters.query().toUtf8(), timeout, profile);
+}
+
+NetworkFuture* NetworkManager::postHTTP_async(const QUrl &link, const PostBody &post_body, const QUrlQuery &get_parameters, const int &timeout, const int &profile)
+{
+    return queue_request(new NetworkFuture(this), QNetworkAccessManager::PostOperation, link, get_parameters,
+                         post_body.data(), timeout, profile);
+}
+
+/**
+ * @brief NetworkManager::queue_request
+ *      Adds an asynchronous request to the queue of the limiter and dispatches the queue.
+ * @param future
+ *      The future that receives the reply, when the request is sent.
+ * @param operation
+ *      GetOperation or PostOperation.
+ * @param link
+ *      URL to perform request. Parametes will be overwritten.
+ * @param get_parameters
+ *      Get parameters to be appended to the URL.
+ * @param body
+ *      Body of the post requests, already encoded. It is implicitly shared, not copied.
+ * @param timeout
+ *      Amount of time until de request timeouts, or timeout_auto.
+ * @param profile
+ *      Handle of the header profile, or profile_default for the request of the current user.
+ * @param temp_settings
+ *      Temporary settings, that are applied only for this request.
+ * @return
+ *      The future.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+NetworkFuture* NetworkManager::queue_request(NetworkFuture *future,
+                                             const QNetworkAccessManager::Operation &operation,
+                                             const QUrl &link,
+                                             const QUrlQuery &get_parameters,
+                                             const QByteArray &body,
+                                             const int &timeout,
+                                             const int &profile,
+                                             const QVariantHash &temp_settings)
+{
+    QueuedRequest queued_request;
+    queued_request.future = future;
+    queued_request.operation = operation;
+    queued_request.link = link;
+    queued_request.get_parameters = get_parameters;
+    queued_request.body = body;
+    queued_request.timeout = timeout;
+    queued_request.profile = profile;
+    queued_request.temp_settings = temp_settings;
+    queued_request.queued = route_clock.elapsed();
+
+    queued_requests.append(queued_request);
+    dispatch_requests();
+
+    return future;
+}
+
+/**
+ * @brief NetworkManager::dispatch_requests
+ *      Sends the queued requests that the limiter accepts, in order.
+ *      A request that waits for a host does not hold the requests to other hosts.
+ *      When the next route is full, the following routes are probed in the limiter before the request waits.
+ *      Only the route that accepts the request is selected, the state of the current route is not touched by the probes.
+ * @remarks
+ *      This slot is called when a request is queued, when a request finishes and by the dispatch timer,
+ *      which is set to the first moment a waiting host accepts requests again (rate or Retry-After).
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void NetworkManager::dispatch_requests()
+{
+    int next_dispatch = -1;
+    int i = 0;
+
+    if(!users.isEmpty() && routes_generation != settings_generation.loadAcquire())
+    {
+        build_routes();
+    }
+
+    while(i < queued_requests.size())
+    {
+        QueuedRequest &queued_request = queued_requests[i];
+
+        if(queued_request.future.isNull() || queued_request.future->is_cancelled())
+        {
+            queued_requests.removeAt(i);
+            continue;
+        }
+
+        //Find a route that accepts the request, probing the table without selecting the routes
+        QString host = redirect(queued_request.link).host();
+        int wait = -1;
+        int route_accepted = -1;
+
+        if(users.isEmpty() || routes.isEmpty())
+        {
+            route_manager();
+            wait = request_limiter.wait(host, route_current_key);
+        }
+        else
+        {
+            for(int j = 1; j <= routes.size() && wait != 0; j++)
+            {
+                int index = (route_index + j) % routes.size();
+                wait = request_limiter.wait(host, routes.at(index).key);
+
+                if(wait == 0)
+                {
+                    route_accepted = index;
+                }
+                else if(wait > 0)
+                {
+                    //The host is waiting, no route can send it
+                    break;
+                }
+            }
+        }
+
+        if(wait != 0)
+        {
+            if(wait > 0 && (next_dispatch < 0 || wait < next_dispatch))
+            {
+                next_dispatch = wait;
+            }
+
+            i++;
+            continue;
+        }
+
+        //Throttle once, to the route that accepted it
+        if(route_accepted >= 0)
+        {
+            select_route(route_accepted);
+        }
+
+        //Backup and set current request settings
+        QNetworkRequest original_request;
+
+        if(!queued_request.temp_settings.isEmpty())
+        {
+            original_request = request_manager;
+            set_request(queued_request.temp_settings);
+        }
+
+        QNetworkReply *reply = send_request(queued_request.operation, queued_request.link, queued_request.get_parameters,
+                                            queued_request.body, queued_request.timeout, queued_request.profile, true);
+
+        //Restore settings
+        if(!queued_request.temp_settings.isEmpty())
+        {
+            request_manager.swap(original_request);
+        }
+
+        reply->setProperty("queued", queued_request.queued);
+        queued_request.future->set_reply(reply);
+        queued_requests.removeAt(i);
+    }
+
+    if(next_dispatch > 0)
+    {
+        dispatch_timer->start(next_dispatch);
+    }
+}
+
+/**
+ * @brief NetworkManager::getHTTP_batch
+ *      Makes a batch of get requests, spread over the routes of this instance in a single pass.
+ *      The routes are planned first, the requests are then issued route by route: each route is selected
+ *      and its request prepared (headers and TLS session) once for the whole batch, each item only sets its own URL.
+ * @param link
+ *      URL to perform the requests. Parametes will be overwritten.
+ * @param get_parameters
+ *      Get parameters of each request, one request is made for each entry.
+ * @param timeout
+ *      Amount of time until each request timeouts.
+ * @return
+ *      The completion handle of the batch, with one future for each request, in the same order.
+ *      The receiver of the result must delete it. An empty batch finishes on the next event loop.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+NetworkBatch* NetworkManager::getHTTP_batch(QUrl link, const QList<QUrlQuery> &get_parameters, const int &timeout)
+{
+    link = redirect(link);
+
+    NetworkBatch *batch = new NetworkBatch(this);
+
+    if(get_parameters.isEmpty())
+    {
+        //The continuation is set after this returns
+        QMetaObject::invokeMethod(batch, "finish_empty", Qt::QueuedConnection);
+        return batch;
+    }
+
+    //Plan the routes, item i goes to the route (first_route + i % routes_used)
+    int routes_used = 1;
+    int first_route = 0;
+
+    if(!users.isEmpty())
+    {
+        if(routes_generation != settings_generation.loadAcquire())
+        {
+            build_routes();
+        }
+
+        if(!routes.isEmpty())
+        {
+            routes_used = qMin(get_parameters.size(), routes.size());
+            first_route = (route_index + 1) % routes.size();
+        }
+    }
+
+    QVector<NetworkFuture*> futures(get_parameters.size());
+
+    for(int j = 0; j < routes_used; j++)
+    {
+        if(!users.isEmpty() && !routes.isEmpty())
+        {
+            select_route((first_route + j) % routes.size());
+        }
+
+        //Prepare the request of the route, once per batch
+        QNetworkAccessManager *manager = route_manager();
+        QNetworkRequest request = request_manager;
+        request.setRawHeader("Accept-Encoding", StreamDecoder::accept_encoding());
+        QString session = set_session(request, link);
+
+        for(int i = j; i < get_parameters.size(); i += routes_used)
+        {
+            //Add GET parameters
+            link.setQuery(get_parameters.at(i));
+            request.setUrl(link);
+
+            //Perform GET request
+            QNetworkReply* reply = manager->get(request);
+            set_reply(reply, session, timeout);
+
+            futures[i] = new NetworkFuture();
+            futures[i]->set_reply(reply);
+        }
+    }
+
+    for(int i = 0; i < futures.size(); i++)
+    {
+        batch->add(futures.at(i));
+    }
+
+    return batch;
+}
+
 /**
  * @brief NetworkManager::request
  *      Used to get the internal object of the request.
@@ -233,21 +700,23 @@ PersistentCookieJar* NetworkManager::cookiejar() const
  *      The url
  * @return
  *      List of cookies from the specific user and url.
+ * @remarks
+ *      The cookies of the user are shared by the snapshots of all instances, and its lookups are memoized.
+ *      Nothing is allocated or copied per call.
  * @date
  *      Created:  Filipe, 3 Jul 2014
- *      Modified: Filipe, 3 Jul 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
 QList<QNetworkCookie> NetworkManager::cookiesForUrl(const QString &user, const QUrl &url) const
 {
-    int index = validate_user(user);
-    PersistentCookieJar *cookies = new PersistentCookieJar();
+    const UserSettings *settings = find_user(user);
 
-    if(index >= 0)
+    if(settings == NULL)
     {
-        cookies->set_all_cookies(cookies_settings.at(index));
+        return QList<QNetworkCookie>();
     }
 
-    return cookies->cookiesForUrl(url);
+    return settings->cookies.cookies_for_url(url);
 }
 
 /**
@@ -257,13 +726,90 @@ QList<QNetworkCookie> NetworkManager::cookiesForUrl(const QString &user, const Q
  *      that is why it has a single argument.
  * @param settings
  *      All the settings to be set.
+ * @date
+ *      Created:  Filipe, 13 Apr 2014
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void NetworkManager::set_request(const QVariantHash &settings)
+{
+    apply_settings(request_manager, settings);
+}
+
+/**
+ * @brief NetworkManager::add_profile
+ *      Adds a header profile, the settings are applied on top of the request of each user.
+ *      The handle selects the profile in getHTTP and postHTTP, without walking the settings or copying the request.
+ * @param settings
+ *      The settings of the profile, same as set_request.
+ * @return
+ *      The handle of the profile.
+ * @remarks
+ *      The requests of the profiles are built once per user, on its first request (see profile_request).
+ *      Each profile has a variant with Accept-Encoding, for the NetworkFuture requests, and one without.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+int NetworkManager::add_profile(const QVariantHash &settings)
+{
+    profile_settings.append(settings);
+    profile_requests.clear();
+
+    return profile_settings.size() - 1;
+}
+
+/**
+ * @brief NetworkManager::profile_request
+ *      Gets the request of a header profile for the current user.
+ *      The requests of all the profiles of a user are built together, from the request of the user, on first use.
+ * @param profile
+ *      Handle of the profile, from add_profile.
+ * @param encoded
+ *      True for the variant with Accept-Encoding, decoded by the NetworkFuture.
+ * @return
+ *      The request of the profile. It is implicitly shared, the caller copies it to set the URL.
+ * @remarks
+ *      Changes made with request() after the first request of a user do not reach its profiles.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+const QNetworkRequest& NetworkManager::profile_request(const int &profile, const bool &encoded)
+{
+    QVector<QNetworkRequest> &requests = profile_requests[current_manager];
+
+    if(requests.isEmpty())
+    {
+        //Plain and encoded variant of each profile, side by side
+        for(int i = 0; i < profile_settings.size(); i++)
+        {
+            QNetworkRequest request = request_manager;
+            request.setRawHeader("Accept-Encoding", QByteArray());
+            apply_settings(request, profile_settings.at(i));
+            requests.append(request);
+
+            request.setRawHeader("Accept-Encoding", StreamDecoder::accept_encoding());
+            requests.append(request);
+        }
+    }
+
+    return requests.at(profile * 2 + (encoded ? 1 : 0));
+}
+
+/**
+ * @brief NetworkManager::apply_settings
+ *      Applies settings to a request. Used by set_request and add_profile.
+ * @param request
+ *      The request to change.
+ * @param settings
+ *      All the settings to be set.
  * @remarks
  *      This function is ready to add more settings with ease.
  * @date
  *      Created:  Filipe, 13 Apr 2014
- *      Modified: Filipe, 13 Apr 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
-void NetworkManager::set_request(const QVariantHash &settings)
+void NetworkManager::apply_settings(QNetworkRequest &request, const QVariantHash &settings)
 {
     QList<QString> settings_keys = settings.keys();
     for(int i = 0; i < settings_keys.size(); i++)
@@ -282,11 +828,11 @@ void NetworkManager::set_request(const QVariantHash &settings)
                 priority = QNetworkRequest::LowPriority;
             }
 
-            request_manager.setPriority(priority);
+            request.setPriority(priority);
         }
         else
         {
-            request_manager.setRawHeader(settings_keys.at(i).toUtf8(), settings.value(settings_keys.at(i)).toByteArray());
+            request.setRawHeader(settings_keys.at(i).toUtf8(), settings.value(settings_keys.at(i)).toByteArray());
         }
     }
 }
@@ -294,6 +840,7 @@ void NetworkManager::set_request(const QVariantHash &settings)
 /**
  * @brief NetworkManager::set_proxy
  *      Sets a proxy in the manager, and copys all headers from the request.
+ *      The proxy is only applied to the route used by the next requests, see route_manager.
  * @param type
  * @param hostname
  * @param hostport
@@ -302,7 +849,7 @@ void NetworkManager::set_request(const QVariantHash &settings)
  * @param password
  * @date
  *      Created:  Filipe, 2 Apr 2014
- *      Modified: Filipe, 13 Apr 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
 void NetworkManager::set_proxy(const QNetworkProxy::ProxyType &type,
                                const QString &hostname,
@@ -322,69 +869,70 @@ void NetworkManager::set_proxy(const QNetworkProxy::ProxyType &type,
         proxy_manager.setRawHeader(raw_headers.at(i), request_manager.rawHeader(raw_headers.at(i)));
     }
 
-    setProxy(proxy_manager);
+    route_current = NULL;
 }
 
 /**
  * @brief NetworkManager::save_settings
- *      Saves the network object settings in static variables.
+ *      Saves the network object settings in the static registry.
  * @param user
  *      The name of the setting to be saved.
  *      This is obligatory, all settigs must have a name/user.
  * @remarks
- *      This method writes data to the static arrays it should be thread-safe.
+ *      This method writes data to the static registry it should be thread-safe.
  * @date
  *      Created:  Filipe, 24 Mar 2014
- *      Modified: Filipe, 3 Sep 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
 void NetworkManager::save_settings(const QString &user)
 {
-    if(validate_user(user) < 0)
+    mutex.lock();
+    if(!user_settings.contains(user))
     {
-        mutex.lock();
-        QList<QNetworkProxy> proxys;
-        proxys.prepend(this->proxy());
+        UserSettings settings;
+        settings.request = request_manager;
+        settings.proxys.prepend(proxy_manager);
+        settings.cookies = cookies_manager->cookies();
 
-        user_settings.append(user);
-        proxy_settings.append(proxys);
-        request_settings.append(request_manager);
-        cookies_settings.append(cookies_manager->all_cookies());
-        mutex.unlock();
+        user_settings.insert(user, settings);
+        settings_generation.ref();
     }
+    mutex.unlock();
 }
 
 /**
  * @brief NetworkManager::load_settings
- *      Loads the network object with the static variables.
+ *      Loads the network object with the static registry.
  * @param user
  *      Name of the setting to be loaded.
- * @param proxy_index
- *      Index of the proxy.
+ * @param load_cookies
+ *      If the cookies of the user are to be loaded. The set of the user is shared, not copied.
  * @date
  *      Created:  Filipe, 24 Mar 2014
- *      Modified: Filipe, 3 Sep 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
 void NetworkManager::load_settings(const QString &user, const bool &load_cookies)
 {
-    int index = validate_user(user);
+    const UserSettings *settings = find_user(user);
 
-    if(index >= 0)
+    if(settings != NULL)
     {
         if(current_manager != user)
         {
-            current_manager = user_settings.value(index);
-            request_manager = request_settings.value(index);
+            current_manager = user;
+            route_user = users.indexOf(user);
+            request_manager = settings->request;
 
             if(load_cookies)
             {
-                cookies_manager->set_all_cookies(cookies_settings.value(index));
+                cookies_manager->set_cookies(settings->cookies);
             }
         }
 
         //Proxy is always set, even with 1 user and 1 proxy.
         //This is done because the current proxy might be removed in the middle of the throttle, this will restore the balance.
-        proxy_manager = proxy_settings.at(index).value(0);
-        setProxy(proxy_manager);
+        proxy_manager = settings->proxys.value(0);
+        route_current = NULL;
     }
 }
 
@@ -397,19 +945,20 @@ void NetworkManager::load_settings(const QString &user, const bool &load_cookies
  *      The proxy to be added. To add multiple proxys use the save_proxys function.
  * @date
  *      Created:  Filipe, 3 Jul 2014
- *      Modified: Filipe, 3 Sep 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
 void NetworkManager::add_proxy(const QString &user, QNetworkProxy &proxy)
 {
-    int index = validate_user(user);
+    mutex.lock();
+    QHash<QString, UserSettings>::iterator settings = user_settings.find(user);
 
-    if(index >= 0)
+    if(settings != user_settings.end())
     {
-        mutex.lock();
-        parse_proxy_headers(index, proxy);
-        proxy_settings[index].append(proxy);
-        mutex.unlock();
+        parse_proxy_headers(settings.value().request, proxy);
+        settings.value().proxys.append(proxy);
+        settings_generation.ref();
     }
+    mutex.unlock();
 }
 
 /**
@@ -421,27 +970,27 @@ void NetworkManager::add_proxy(const QString &user, QNetworkProxy &proxy)
  *      The proxy to be removed.
  * @date
  *      Created:  Filipe, 3 Jul 2014
- *      Modified: Filipe, 3 Jul 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
 void NetworkManager::remove_proxy(const QString &user, const QNetworkProxy &proxy)
 {
-    int index = validate_user(user);
+    mutex.lock();
+    QHash<QString, UserSettings>::iterator settings = user_settings.find(user);
 
-    if(index >= 0)
+    if(settings != user_settings.end())
     {
         //Never remove the first one (set by the login)
-        for(int i = 1; i < proxy_settings.at(index).size(); i++)
+        for(int i = 1; i < settings.value().proxys.size(); i++)
         {
-            if(proxy_settings.at(index).at(i) == proxy)
+            if(settings.value().proxys.at(i) == proxy)
             {
-                mutex.lock();
-                proxy_settings[index].removeAt(i);
-                mutex.unlock();
-
+                settings.value().proxys.removeAt(i);
+                settings_generation.ref();
                 break;
             }
         }
     }
+    mutex.unlock();
 }
 
 /**
@@ -456,133 +1005,870 @@ void NetworkManager::remove_proxy(const QString &user, const QNetworkProxy &prox
  *      If the current proxys are to be cleared or just append.
  * @date
  *      Created:  Filipe, 20 Jun 2014
- *      Modified: Filipe, 20 Jun 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
 void NetworkManager::save_proxys(const QString &user, QList<QNetworkProxy> &proxys, const bool &clear_current)
 {
-    int index = validate_user(user);
+    mutex.lock();
+    QHash<QString, UserSettings>::iterator settings = user_settings.find(user);
 
-    if(index >= 0)
+    if(settings != user_settings.end())
     {
-        mutex.lock();
         if(clear_current)
         {
             //Never remove the first one (set by the login).
-            for(int i = 1; i < proxy_settings.at(index).size(); i++)
-            {
-                proxy_settings[index].removeAt(i);
-            }
+            settings.value().proxys = settings.value().proxys.mid(0, 1);
         }
 
         for(int i = 0; i < proxys.size(); i++)
         {
-            parse_proxy_headers(index, proxys[i]);
-            proxy_settings[index].append(proxys[i]);
+            parse_proxy_headers(settings.value().request, proxys[i]);
+            settings.value().proxys.append(proxys[i]);
         }
-        mutex.unlock();
+
+        settings_generation.ref();
     }
+    mutex.unlock();
 }
 
 /**
  * @brief NetworkManager::parse_proxy_headers
  *      Copys the headers from the request, that are set by the login to the passed proxy.
- * @param user_index
- *      The user index to locate the request.
+ * @param request
+ *      The request of the user.
  * @param proxy
  *      Proxy to be modifyed.
- * @remarks
- *      TEST
+ * @date
+ *      Created:  Filipe, 3 Jul 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
-void NetworkManager::parse_proxy_headers(const int &user_index, QNetworkProxy &proxy)
+void NetworkManager::parse_proxy_headers(const QNetworkRequest &request, QNetworkProxy &proxy)
 {
-    QList<QByteArray> raw_headers = request_settings[user_index].rawHeaderList();
+    QList<QByteArray> raw_headers = request.rawHeaderList();
     for(int i = 0; i < raw_headers.size(); i++)
     {
-        proxy.setRawHeader(raw_headers.at(i), request_settings[user_index].rawHeader(raw_headers.at(i)));
+        proxy.setRawHeader(raw_headers.at(i), request.rawHeader(raw_headers.at(i)));
     }
 }
 
 /**
- * @brief NetworkManager::throttle_settings
- *      If this instance has users, this function will throttle between all users and all proxys.
+ * @brief NetworkManager::set_endpoint
+ *      Sends all the requests for the Steam hosts (steampowered.com and steamcommunity.com) to another server,
+ *      e.g. the MockMarket server to test offline. The path and query are kept.
+ * @param url
+ *      Scheme, host and port of the server. An empty URL restores the Steam hosts.
+ * @remarks
+ *      Set it before any request is made, it is not thread-safe.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void NetworkManager::set_endpoint(const QUrl &url)
+{
+    endpoint = url;
+}
+
+/**
+ * @brief NetworkManager::resolve_hosts
+ *      Resolves ahead of time the proxys of all the users and the Steam hosts, see DnsCache.
+ *      It returns immediately, the lookups are made in the background and refreshed before they expire.
+ * @param hosts
+ *      Other hosts to be resolved.
+ * @remarks
+ *      Call it at login, so the first requests of every route do not wait on DNS.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void NetworkManager::resolve_hosts(const QStringList &hosts) const
+{
+    QStringList all_hosts(hosts);
+    all_hosts << "steamcommunity.com" << "store.steampowered.com" << "api.steampowered.com";
+
+    if(!endpoint.isEmpty())
+    {
+        all_hosts << endpoint.host();
+    }
+
+    if(!proxy_manager.hostName().isEmpty())
+    {
+        all_hosts << proxy_manager.hostName();
+    }
+
+    refresh_snapshot();
+
+    QHash<QString, UserSettings>::const_iterator it;
+    for(it = snapshot_settings.constBegin(); it != snapshot_settings.constEnd(); ++it)
+    {
+        for(int i = 0; i < it.value().proxys.size(); i++)
+        {
+            all_hosts << it.value().proxys.at(i).hostName();
+        }
+    }
+
+    DnsCache::resolve(all_hosts);
+}
+
+/**
+ * @brief NetworkManager::throttle_settings
+ *      If this instance has users, this function will throttle between all users and all proxys.
+ *      This only selects the route, the connections of the previous route are kept alive.
+ * @remarks
+ *      The cursor advances over the route table in O(1). When the registry changes (e.g. a proxy is removed)
+ *      the table is rebuilt and the cursor continues from the same position, instead of resetting the cycle.
+ * @remarks
+ *      Switching users swaps the CookieSet of the jar, no cookie is copied. The set is shared with the registry
+ *      and the other instances, the jar only copies it when a reply changes a cookie (copy-on-write).
  * @date
  *      Created:  Filipe, 21 Jun 2014
- *      Modified: Filipe, 21 Jun 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
 void NetworkManager::throttle_settings()
 {
-    bool found = false;
-    int current_index = validate_user(current_manager);
+    if(routes_generation != settings_generation.loadAcquire())
+    {
+        build_routes();
+    }
 
-    if(current_index >= 0 && !proxy_settings.at(current_index).isEmpty())
+    if(!routes.isEmpty())
     {
-        if(proxy_manager != proxy_settings.at(current_index).last()) //Change proxy.
+        select_route((route_index + 1) % routes.size());
+    }
+}
+
+/**
+ * @brief NetworkManager::select_route
+ *      Sets the user and proxy of a route of the table as the current ones, and moves the cursor to it.
+ *      The user (request and cookies) is only set when it changes.
+ * @param index
+ *      Index of the route in the table.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void NetworkManager::select_route(const int &index)
+{
+    route_index = index;
+    Route &route = routes[route_index];
+
+    if(route.user != route_user)
+    {
+        //Set NEXT user.
+        route_user = route.user;
+        current_manager = users.at(route.user);
+        request_manager = route.settings->request;
+        cookies_manager->set_cookies(route.settings->cookies);
+    }
+
+    //Set NEXT proxy.
+    proxy_manager = route.settings->proxys.at(route.proxy);
+
+    if(route.manager == NULL)
+    {
+        route_current = NULL;
+        route.manager = route_manager();
+    }
+
+    route_current = route.manager;
+    route_current_key = route.key;
+}
+
+/**
+ * @brief NetworkManager::build_routes
+ *      Builds the route table of this instance, one entry for each proxy of each user, in the throttle order.
+ *      The access managers of the routes that already exist are kept.
+ *      The access managers of the routes that are gone (e.g. a proxy was removed) are retired, with their histograms.
+ * @remarks
+ *      A retired manager is only deleted when it has no replies left, see release_routes.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void NetworkManager::build_routes()
+{
+    refresh_snapshot();
+    routes.clear();
+
+    QSet<QString> routes_keys;
+
+    for(int i = 0; i < users.size(); i++)
+    {
+        QHash<QString, UserSettings>::const_iterator settings = snapshot_settings.constFind(users.at(i));
+
+        if(settings != snapshot_settings.constEnd())
         {
-            for(int i = 0; i < proxy_settings.at(current_index).size() - 1; i++)
-            {
-                if(proxy_manager == proxy_settings.at(current_index).at(i))
-                {
-                    //Set NEXT proxy, current user.
-                    proxy_manager = proxy_settings.at(current_index).at(i + 1);
-                    setProxy(proxy_manager);
-                    found = true;
-                    break;
-                }
-            }
-            if(!found)
+            for(int j = 0; j < settings.value().proxys.size(); j++)
             {
-                //Proxy was removed, reset cycle.
-                load_settings(users.at(0));
+                Route route;
+                route.user = i;
+                route.proxy = j;
+                route.settings = &settings.value();
+                route.key = route_key(users.at(i), settings.value().proxys.at(j));
+                route.manager = route_managers.value(route.key, NULL);
+
+                routes.append(route);
+                routes_keys.insert(route.key);
             }
         }
-        else //Change user.
+    }
+
+    //Retire the managers of the routes that are gone
+    QHash<QString, QNetworkAccessManager*>::iterator it = route_managers.begin();
+
+    while(it != route_managers.end())
+    {
+        if(routes_keys.contains(it.key()))
         {
-            if(current_manager != users.last())
+            ++it;
+            continue;
+        }
+
+        if(route_current == it.value())
+        {
+            route_current = NULL;
+        }
+
+        route_latency.remove(it.key());
+        route_phases.remove(it.key());
+        route_retired.append(it.value());
+        it = route_managers.erase(it);
+    }
+
+    routes_generation = snapshot_generation;
+
+    if(route_index >= routes.size())
+    {
+        route_index = routes.size() - 1;
+    }
+
+    release_routes();
+}
+
+/**
+ * @brief NetworkManager::release_routes
+ *      Deletes the retired access managers that have no replies left.
+ *      The replies are children of their manager, a manager deleted earlier would delete the replies
+ *      still held by the callers and the futures.
+ * @remarks
+ *      Called when the routes are built and when a reply finishes.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void NetworkManager::release_routes()
+{
+    int i = 0;
+
+    while(i < route_retired.size())
+    {
+        if(route_retired.at(i)->findChildren<QNetworkReply*>(QString(), Qt::FindDirectChildrenOnly).isEmpty())
+        {
+            route_retired.takeAt(i)->deleteLater();
+        }
+        else
+        {
+            i++;
+        }
+    }
+}
+
+/**
+ * @brief NetworkManager::route_manager
+ *      Gets the access manager of the current route (user and proxy), creating it on first use.
+ *      Each route keeps its own pool of keep-alive connections, so switching between routes
+ *      never closes a connection that is still warm.
+ * @remarks
+ *      All the routes share the cookie jar of this instance. Since setCookieJar takes the ownership,
+ *      the parent of the jar is restored to this instance.
+ * @remarks
+ *      The proxy is set by address when the DnsCache has it, when an address changes the routes are updated.
+ * @return
+ *      The access manager to perform the request.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+QNetworkAccessManager* NetworkManager::route_manager()
+{
+    //The address of a proxy changed, reconnect the routes to the new one
+    if(dns_generation != DnsCache::generation())
+    {
+        dns_generation = DnsCache::generation();
+
+        for(int i = 0; i < routes.size(); i++)
+        {
+            if(routes.at(i).manager != NULL)
             {
-                for(int i = 0; i < users.size() - 1; i++)
-                {
-                    if(current_manager == users.at(i))
-                    {
-                        //Set NEXT user, first proxy.
-                        load_settings(users.at(i + 1));
-                        break;
-                    }
-                }
+                routes.at(i).manager->setProxy(resolve_proxy(routes.at(i).settings->proxys.at(routes.at(i).proxy)));
             }
-            else
+        }
+
+        if(users.isEmpty() && route_current != NULL)
+        {
+            route_current->setProxy(resolve_proxy(proxy_manager));
+        }
+    }
+
+    if(route_current == NULL)
+    {
+        route_current_key = route_key(current_manager, proxy_manager);
+        route_current = route_managers.value(route_current_key, NULL);
+
+        if(route_current == NULL)
+        {
+            route_current = new QNetworkAccessManager(this);
+            route_current->setProxy(resolve_proxy(proxy_manager));
+            route_current->setCookieJar(cookies_manager);
+            cookies_manager->setParent(this);
+
+            if(caching)
             {
-                //Set FIRST user, first proxy.
-                load_settings(users.at(0));
+                route_current->setCache(new ResponseCache(current_manager));
             }
+
+            connect(route_current, SIGNAL(finished(QNetworkReply*)), this, SLOT(reply_finished(QNetworkReply*)));
+            connect(route_current, SIGNAL(finished(QNetworkReply*)), this, SIGNAL(finished(QNetworkReply*)));
+            connect(route_current, SIGNAL(encrypted(QNetworkReply*)), this, SLOT(reply_encrypted(QNetworkReply*)));
+            route_managers.insert(route_current_key, route_current);
+        }
+    }
+
+    return route_current;
+}
+
+/**
+ * @brief NetworkManager::route_key
+ *      Builds the key that identifies a route.
+ * @param user
+ *      The network user of the route.
+ * @param proxy
+ *      The proxy of the route.
+ * @return
+ *      The key of the route.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+QString NetworkManager::route_key(const QString &user, const QNetworkProxy &proxy)
+{
+    return user + "|" +
+           QString::number(proxy.type()) + "|" +
+           proxy.hostName() + ":" +
+           QString::number(proxy.port()) + "|" +
+           proxy.user();
+}
+
+/**
+ * @brief NetworkManager::redirect
+ *      Replaces the Steam host of a link with the endpoint, if one was set.
+ * @param link
+ *      URL of the request.
+ * @return
+ *      The URL to request.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+QUrl NetworkManager::redirect(QUrl link)
+{
+    if(!endpoint.isEmpty() &&
+       (link.host().endsWith("steampowered.com") || link.host().endsWith("steamcommunity.com")))
+    {
+        link.setScheme(endpoint.scheme());
+        link.setHost(endpoint.host());
+        link.setPort(endpoint.port());
+    }
+
+    return link;
+}
+
+/**
+ * @brief NetworkManager::resolve_proxy
+ *      Replaces the host name of a proxy with its address in the DnsCache.
+ * @param proxy
+ *      The proxy.
+ * @return
+ *      The proxy to connect to. Unchanged if the address is not known yet.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+QNetworkProxy NetworkManager::resolve_proxy(QNetworkProxy proxy)
+{
+    if(!proxy.hostName().isEmpty())
+    {
+        proxy.setHostName(DnsCache::address(proxy.hostName()));
+    }
+
+    return proxy;
+}
+
+/**
+ * @brief NetworkManager::set_session
+ *      Sets the TLS session of the current route in the request, so the handshake can be resumed.
+ * @param request
+ *      The request that is sent (the request of the user, of a profile or of a batch).
+ * @param link
+ *      URL of the request. Only HTTPS requests have a session.
+ * @return
+ *      The key of the session (host and proxy). Empty if the request is not encrypted.
+ * @remarks
+ *      The user is not part of the key, so the session of the login is resumed by the listings and the other users.
+ *      The proxy is, a ticket is only resumed over the same path.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+QString NetworkManager::set_session(QNetworkRequest &request, const QUrl &link)
+{
+    QString session = "";
+
+    if(link.scheme() == "https")
+    {
+        session = link.host() + "|" +
+                  QString::number(proxy_manager.type()) + "|" +
+                  proxy_manager.hostName() + ":" +
+                  QString::number(proxy_manager.port());
+
+        QSslConfiguration ssl_configuration = request.sslConfiguration();
+        ssl_configuration.setSslOption(QSsl::SslOptionDisableSessionPersistence, false);
+        ssl_configuration.setSessionTicket(SessionCache::get_ticket(session));
+        request.setSslConfiguration(ssl_configuration);
+    }
+
+    return session;
+}
+
+/**
+ * @brief NetworkManager::set_reply
+ *      Tracks a reply that was just created on the current route.
+ *      Marks the TLS session, the route and the start time, used by reply_finished, and adds the timeout to the wheel.
+ *      Every request is counted by the limiter, including the ones that were not queued (getHTTP, postHTTP and batches).
+ *      The time of the headers is marked by reply_headers, for the phases of the request.
+ * @param reply
+ *      The reply of the request.
+ * @param session
+ *      The key of the TLS session, empty if the request is not https.
+ * @param timeout
+ *      Amount of time until de request timeouts, or timeout_auto.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void NetworkManager::set_reply(QNetworkReply *reply, const QString &session, const int &timeout)
+{
+    if(!session.isEmpty())
+    {
+        reply->setProperty("session", session);
+    }
+
+    reply->setProperty("route", route_current_key);
+    reply->setProperty("host", reply->url().host());
+    reply->setProperty("started", route_clock.elapsed());
+    request_limiter.acquire(reply->url().host(), route_current_key);
+    connect(reply, SIGNAL(metaDataChanged()), this, SLOT(reply_headers()));
+
+    int reply_timeout = (timeout == timeout_auto) ? this->timeout(route_current_key) : timeout;
+
+    if(reply_timeout > 0)
+    {
+        timer_wheel->add(reply, reply_timeout);
+    }
+}
+
+/**
+ * @brief NetworkManager::reply_finished
+ *      This slot is received from the finished() signal of every route.
+ *      Stores the TLS session of the reply, to be resumed by any other instance.
+ *      Adds the latency and the phases of the request to the histograms of its route.
+ *      A timed out request is a sample at its timeout, so the automatic timeout of a slow route grows instead of timing out forever.
+ *      Releases the request in the limiter and dispatches the queue. The retired routes are deleted when they are done.
+ * @param reply
+ *      The finished reply. It is not deleted here.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void NetworkManager::reply_finished(QNetworkReply *reply)
+{
+    QString session = reply->property("session").toString();
+
+    //Release the request, 429 and 503 slow down the host
+    if(reply->property("host").isValid())
+    {
+        request_limiter.release(reply->property("host").toString(),
+                                reply->property("route").toString(),
+                                reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt(),
+                                reply->rawHeader("Retry-After"));
+    }
+
+    if(!session.isEmpty() && reply->error() == QNetworkReply::NoError)
+    {
+        SessionCache::set_ticket(session, reply->sslConfiguration().sessionTicket());
+    }
+
+    //Failed requests are not samples, timed out requests are samples at their timeout
+    bool timed_out = reply->property("timed_out").toBool();
+
+    if((reply->error() == QNetworkReply::NoError || timed_out) && reply->property("started").isValid())
+    {
+        int latency = static_cast<int>(route_clock.elapsed() - reply->property("started").toLongLong());
+        route_latency[reply->property("route").toString()].add(latency);
+    }
+
+    //Phases, only for requests that got an answer
+    if(reply->property("headers").isValid())
+    {
+        qint64 finished = route_clock.elapsed();
+        qint64 started = reply->property("started").toLongLong();
+        qint64 queued = reply->property("queued").isValid() ? reply->property("queued").toLongLong() : started;
+        qint64 encrypted = reply->property("encrypted").isValid() ? reply->property("encrypted").toLongLong() : started;
+        qint64 headers = reply->property("headers").toLongLong();
+
+        QVector<LatencyHistogram> &histograms = route_phases[reply->property("route").toString()];
+        histograms.resize(phases_size);
+
+        //Only the queued requests are samples of the queue, the others never waited
+        if(reply->property("queued").isValid())
+        {
+            histograms[phase_queue].add(static_cast<int>(started - queued));
         }
+
+        histograms[phase_first_byte].add(static_cast<int>(headers - encrypted));
+        histograms[phase_download].add(static_cast<int>(finished - headers));
+        histograms[phase_total].add(static_cast<int>(finished - queued));
+
+        if(reply->property("encrypted").isValid())
+        {
+            histograms[phase_connect].add(static_cast<int>(encrypted - started));
+        }
+    }
+
+    if(!route_retired.isEmpty())
+    {
+        release_routes();
+    }
+
+    if(!queued_requests.isEmpty())
+    {
+        dispatch_requests();
     }
 }
 
 /**
- * @brief NetworkManager::validate_user
- *      The passed user exists? What is the index?
+ * @brief NetworkManager::reply_encrypted
+ *      This slot is received from the encrypted() signal of the route managers.
+ *      Marks the end of the connection phase (DNS, TCP and TLS handshake) of https requests.
+ * @param reply
+ *      The reply of the request.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void NetworkManager::reply_encrypted(QNetworkReply *reply)
+{
+    reply->setProperty("encrypted", route_clock.elapsed());
+}
+
+/**
+ * @brief NetworkManager::reply_headers
+ *      This slot is received from the metaDataChanged() signal of the replys.
+ *      Marks the time to the first byte, only the first headers of the reply are used.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void NetworkManager::reply_headers()
+{
+    QNetworkReply *reply = qobject_cast<QNetworkReply*>(sender());
+
+    if(reply != NULL && !reply->property("headers").isValid())
+    {
+        reply->setProperty("headers", route_clock.elapsed());
+    }
+}
+/**
+ * @brief NetworkManager::coalesced_finished
+ *      This slot is received from the finished() and cancelled() signals of a coalesced request.
+ *      Identical requests made from now on are sent again.
+ * @param leader
+ *      The future of the coalesced request.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void NetworkManager::coalesced_finished(NetworkFuture *leader)
+{
+    coalesced_requests.remove(leader->property("coalesced").toString());
+    leader->deleteLater();
+}
+
+/**
+ * @brief NetworkManager::find_user
+ *      Finds the settings of a user in the snapshot of this instance.
+ *      This is a lock-free hash lookup, the lock is only taken when the snapshot is outdated.
  * @param user
- *      User to be tested
+ *      User to be found.
  * @return
- *      Index of the user. -1 = Does not exit.
+ *      The settings of the user, NULL if the user does not exist.
+ *      The pointer is only valid until the snapshot is refreshed, do not store it.
  * @date
  *      Created:  Filipe, 20 Jun 2014
- *      Modified: Filipe, 20 Jun 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
-int NetworkManager::validate_user(const QString &user)
+const NetworkManager::UserSettings* NetworkManager::find_user(const QString &user) const
 {
-    int index = -1;
+    refresh_snapshot();
+
+    QHash<QString, UserSettings>::const_iterator settings = snapshot_settings.constFind(user);
 
-    for(int i = 0; i < user_settings.size(); i++)
+    if(settings == snapshot_settings.constEnd())
     {
-        if(user_settings.value(i) == user)
+        return NULL;
+    }
+
+    return &settings.value();
+}
+
+/**
+ * @brief NetworkManager::refresh_snapshot
+ *      Refreshes the snapshot of this instance if the registry generation changed.
+ *      Copying the registry only increments a reference count, the writers detach their own copy.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void NetworkManager::refresh_snapshot() const
+{
+    if(snapshot_generation != settings_generation.loadAcquire())
+    {
+        mutex.lock();
+        snapshot_settings = user_settings;
+        snapshot_generation = settings_generation.loadAcquire();
+        mutex.unlock();
+    }
+}
+
+/**
+ * @brief NetworkManager::set_coalescing
+ *      Enables or disables the coalescing of identical asynchronous GET requests (same URL, query, timeout and profile).
+ *      A request identical to one in flight attaches to it and shares its body, it is not sent again.
+ * @param enabled
+ *      Coalescing state, disabled by default.
+ * @remarks
+ *      The user is not part of the key, the result is shared between all the users of this instance.
+ *      Use it for pages that do not depend on the account, e.g. the market listings.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void NetworkManager::set_coalescing(const bool &enabled)
+{
+    coalescing = enabled;
+}
+
+/**
+ * @brief NetworkManager::set_caching
+ *      Enables or disables the response cache of the GET requests.
+ *      Responses with ETag or Last-Modified are stored, the next request for the same URL is conditional
+ *      and a 304 is served from memory. Unchanged pages cost no bandwidth, see NetworkFuture::is_cached.
+ * @param enabled
+ *      Caching state, disabled by default. Applies to all the routes of this instance.
+ * @remarks
+ *      The cache is shared by all instances, each user has its own entries (see ResponseCache).
+ *      The entries are kept when an instance disables it.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void NetworkManager::set_caching(const bool &enabled)
+{
+    caching = enabled;
+
+    QHash<QString, QNetworkAccessManager*>::const_iterator it;
+    for(it = route_managers.constBegin(); it != route_managers.constEnd(); ++it)
+    {
+        it.value()->setCache(caching ? new ResponseCache(it.key().section('|', 0, 0)) : NULL);
+    }
+}
+
+/**
+ * @brief NetworkManager::coalesced
+ *      Number of requests that were not sent because an identical one was in flight.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+int NetworkManager::coalesced() const
+{
+    return coalesced_count;
+}
+
+/**
+ * @brief NetworkManager::set_limits
+ *      Sets the limits of the asynchronous requests, see RequestLimiter::set_limits.
+ *      The requests over the limits wait in the queue of this instance, instead of being refused by the server.
+ * @param host_limit
+ *      Maximum requests in flight for each host, 0 for no limit.
+ * @param route_limit
+ *      Maximum requests in flight for each route (user and proxy), 0 for no limit.
+ * @param rate
+ *      Maximum requests per second for each host, 0 for no limit.
+ * @param burst
+ *      Requests that can be made at once, when a host was idle.
+ * @remarks
+ *      A 429 or 503 always blocks the host for the Retry-After time, even without limits.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void NetworkManager::set_limits(const int &host_limit, const int &route_limit, const double &rate, const int &burst)
+{
+    request_limiter.set_limits(host_limit, route_limit, rate, burst);
+    dispatch_requests();
+}
+
+/**
+ * @brief NetworkManager::queued
+ *      Number of asynchronous requests waiting for the limiter.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+int NetworkManager::queued() const
+{
+    return queued_requests.size();
+}
+
+/**
+ * @brief NetworkManager::set_timeout_auto
+ *      Sets the automatic timeout, used by requests with timeout_auto.
+ *      The timeout of a route is the 99th percentile of its latency multiplied by the factor, within the bounds.
+ *      Fast routes fail fast, slow routes do not hold a connection for the full fixed timeout.
+ * @param factor
+ *      Multiplier of the 99th percentile, at least 1 so the timeouts of a route can grow.
+ * @param minimum
+ *      Lowest timeout, in milliseconds.
+ * @param maximum
+ *      Highest timeout, in milliseconds. Also used while the route does not have enough samples.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void NetworkManager::set_timeout_auto(const double &factor, const int &minimum, const int &maximum)
+{
+    timeout_factor = qMax(1.0, factor);
+    timeout_minimum = minimum;
+    timeout_maximum = qMax(minimum, maximum);
+}
+
+/**
+ * @brief NetworkManager::timeout
+ *      Automatic timeout of a route.
+ * @param route
+ *      Key of the route, the current route if empty.
+ * @return
+ *      The timeout in milliseconds.
+ * @remarks
+ *      A route needs at least 20 samples, before that the maximum is used.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+int NetworkManager::timeout(const QString &route) const
+{
+    const LatencyHistogram histogram = latency(route);
+
+    if(histogram.count() < 20)
+    {
+        return timeout_maximum;
+    }
+
+    return qBound(timeout_minimum, qRound(histogram.percentile(99) * timeout_factor), timeout_maximum);
+}
+
+/**
+ * @brief NetworkManager::latency
+ *      Latency histogram of a route.
+ * @param route
+ *      Key of the route, the current route if empty.
+ * @return
+ *      A copy of the histogram, empty if the route has no samples.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+LatencyHistogram NetworkManager::latency(const QString &route) const
+{
+    return route_latency.value(route.isEmpty() ? route_current_key : route);
+}
+
+/**
+ * @brief NetworkManager::phase
+ *      Histogram of a phase of the requests of a route.
+ *      queue:          Time waiting in the queue of the limiter, only the NetworkFuture requests that were queued (queue_request).
+ *      connect:        DNS, TCP and TLS handshake, only https requests that opened a connection.
+ *      first_byte:     From the request (or the handshake) to the headers of the reply. Server time.
+ *      download:       From the headers to the end of the reply.
+ *      total:          From the queue (or the request, if it was not queued) to the end of the reply.
+ * @param request_phase
+ *      One of the phases enum.
+ * @param route
+ *      Key of the route, the current route if empty.
+ * @return
+ *      A copy of the histogram, empty if the route has no samples.
+ * @remarks
+ *      Qt does not report the DNS and TCP times separately, they are part of connect.
+ *      Plain http requests have no connect phase, its time is part of first_byte.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+LatencyHistogram NetworkManager::phase(const int &request_phase, const QString &route) const
+{
+    return route_phases.value(route.isEmpty() ? route_current_key : route).value(request_phase);
+}
+
+/**
+ * @brief NetworkManager::print_phases
+ *      Creates a string with the phases of the requests of all routes.
+ *      Use and output method that supports HTML.
+ * @return
+ *      Data to be displayed
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+QString NetworkManager::print_phases() const
+{
+    QString phases_print;
+    QStringList phases_names;
+    phases_names << "Queue" << "Connect" << "First byte" << "Download" << "Total";
+
+    QHash<QString, QVector<LatencyHistogram> >::const_iterator it;
+    for(it = route_phases.constBegin(); it != route_phases.constEnd(); ++it)
+    {
+        phases_print.append("<p>Route: " + it.key() + "</p>");
+
+        for(int i = 0; i < it.value().size(); i++)
         {
-            index = i;
-            break;
+            phases_print.append("<p>" + phases_names.at(i) + " - " + it.value().at(i).print() + "</p>");
         }
     }
 
-    return index;
+    return phases_print;
+}
+
+/**
+ * @brief NetworkManager::timed_out
+ *      Number of requests of this instance that were closed by the timeout system.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+int NetworkManager::timed_out() const
+{
+    return timer_wheel->timed_out();
 }
 
 /**
@@ -593,7 +1879,7 @@ int NetworkManager::validate_user(const QString &user)
  *      Data to be displayed
  * @date
  *      Created:  Filipe, 22 Jun 2014
- *      Modified: Filipe, 22 Jun 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
 /**
  * @brief NetworkManager::print
@@ -632,5 +1918,15 @@ QString NetworkManager::print() const
         request_print.append(proxy_manager.password());
     }
 
+    if(timer_wheel->timed_out() > 0)
+    {
+        request_print.append(" - Timeouts: " + QString::number(timer_wheel->timed_out()));
+    }
+
+    if(request_limiter.is_enabled() || !queued_requests.isEmpty())
+    {
+        request_print.append(" - " + request_limiter.print() + " - Queued: " + QString::number(queued_requests.size()));
+    }
+
     return request_print;
 }
@@ -26,7 +26,15 @@
 #include <QNetworkProxy>
 #include <QNetworkRequest>
 #include <QNetworkAccessManager>
+#include <QSslConfiguration>
 #include <QMutex>
+#include <QHash>
+#include <QSet>
+#include <QVector>
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QTimer>
 
 #include <QJsonArray>
 #include <QJsonObject>
@@ -35,19 +43,38 @@
 
 #include "defines.h"
 #include "persistentcookiejar.h"
-#include "replytimeout.h"
+#include "timerwheel.h"
+#include "latencyhistogram.h"
+#include "responsecache.h"
+#include "requestlimiter.h"
+#include "dnscache.h"
+#include "postbody.h"
+#include "sessioncache.h"
+#include "networkfuture.h"
+#include "networkbatch.h"
 
 /**
  * @brief The NetworkManager class
  *      This class extends the functionality of QNetworkAccessManager by
  *      implementing a persistent storage, a way to save and load data without
- *      IO operations and also implements a custom timeout system. Further more,
+ *      IO operations and also implements a custom timeout system (TimerWheel). Further more,
  *      this class also handles custom headers to the default and proxy requests.
+ *      Header profiles are built once per user (add_profile) and selected per request by handle.
  *      Multiple network users with multiple proxys are suported within the same instance.
  *      A single instance can throttle the requests automaticaly between users and proxys.
+ *      Each route (user and proxy) has its own access manager, so the throttle never tears down warm connections.
+ *      TLS sessions are shared between all instances by the SessionCache.
+ *      The settings of all users are kept in a static registry, each instance reads from its own snapshot of it.
+ *      The cookies of a user are a shared CookieSet, switching users only swaps the set of the jar.
+ *      The latency of each route is kept in a histogram, used by the automatic timeout (timeout_auto).
+ *      The phases of each request (queue, connect, first byte, download) are also kept per route (print_phases).
+ *      Optionally, identical asynchronous GET requests in flight are coalesced into a single request,
+ *      and GET responses are revalidated with conditional requests against the ResponseCache.
+ *      Asynchronous requests go through the RequestLimiter, the excess waits in a queue of this instance.
+ *      The proxys and the Steam hosts are resolved ahead of time by the DnsCache (resolve_hosts).
  * @date
  *      Created:  Filipe, 17 Mar 2014
- *      Modified: Filipe, 11 Apr 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
 class NetworkManager : public QNetworkAccessManager
 {
@@ -62,7 +89,8 @@ public_construct:
 public_methods:
     QNetworkReply* getHTTP(QUrl link,
                            const QUrlQuery &get_parameters = QUrlQuery(),
-                           const int &timeout = 0);
+                           const int &timeout = 0,
+                           const int &profile = profile_default);
 
     QNetworkReply* postHTTP(QUrl link,
                             const QUrlQuery &post_parameters,
@@ -70,11 +98,51 @@ public_methods:
                             const int &timeout = 0,
                             const QVariantHash &temp_settings = QVariantHash());
 
+    QNetworkReply* postHTTP(QUrl link,
+                            const QUrlQuery &post_parameters,
+                            const QUrlQuery &get_parameters,
+                            const int &timeout,
+                            const int &profile);
+
+    QNetworkReply* postHTTP(QUrl link,
+                            const PostBody &post_body,
+                            const QUrlQuery &get_parameters = QUrlQuery(),
+                            const int &timeout = 0,
+                            const int &profile = profile_default);
+
+    NetworkFuture* getHTTP_async(const QUrl &link,
+                                 const QUrlQuery &get_parameters = QUrlQuery(),
+                                 const int &timeout = 0,
+                                 const int &profile = profile_default);
+
+    NetworkFuture* postHTTP_async(const QUrl &link,
+                                  const QUrlQuery &post_parameters,
+                                  const QUrlQuery &get_parameters = QUrlQuery(),
+                                  const int &timeout = 0,
+                                  const QVariantHash &temp_settings = QVariantHash());
+
+    NetworkFuture* postHTTP_async(const QUrl &link,
+                                  const QUrlQuery &post_parameters,
+                                  const QUrlQuery &get_parameters,
+                                  const int &timeout,
+                                  const int &profile);
+
+    NetworkFuture* postHTTP_async(const QUrl &link,
+                                  const PostBody &post_body,
+                                  const QUrlQuery &get_parameters = QUrlQuery(),
+                                  const int &timeout = 0,
+                                  const int &profile = profile_default);
+
+    NetworkBatch* getHTTP_batch(QUrl link,
+                                const QList<QUrlQuery> &get_parameters,
+                                const int &timeout = 0);
+
     QNetworkRequest& request();
     PersistentCookieJar* cookiejar() const;
     QList<QNetworkCookie> cookiesForUrl(const QString &user, const QUrl &url) const;
 
     void set_request(const QVariantHash &settings);
+    int add_profile(const QVariantHash &settings);
     void set_proxy(const QNetworkProxy::ProxyType &type,
                    const QString &hostname = "",
                    const quint16 &hostport = 0,
@@ -87,28 +155,153 @@ public_methods:
     static void add_proxy(const QString &user, QNetworkProxy &proxy);
     static void remove_proxy(const QString &user, const QNetworkProxy &proxy);
     static void save_proxys(const QString &user, QList<QNetworkProxy> &proxys, const bool &clear_current = false);
-    static void parse_proxy_headers(const int &user_index, QNetworkProxy &proxy);
+    static void parse_proxy_headers(const QNetworkRequest &request, QNetworkProxy &proxy);
+    static void set_endpoint(const QUrl &url);
+    void resolve_hosts(const QStringList &hosts = QStringList()) const;
+
+    void set_coalescing(const bool &enabled);
+    void set_caching(const bool &enabled);
+    int coalesced() const;
 
+    void set_limits(const int &host_limit, const int &route_limit, const double &rate = 0, const int &burst = 1);
+    int queued() const;
+
+    void set_timeout_auto(const double &factor, const int &minimum, const int &maximum);
+    int timeout(const QString &route = QString()) const;
+    LatencyHistogram latency(const QString &route = QString()) const;
+    LatencyHistogram phase(const int &request_phase, const QString &route = QString()) const;
+    QString print_phases() const;
+    int timed_out() const;
     QString print() const;
 
 private_methods:
+    QNetworkReply* send_request(const QNetworkAccessManager::Operation &operation,
+                                QUrl link,
+                                const QUrlQuery &get_parameters,
+                                const QByteArray &body,
+                                const int &timeout,
+                                const int &profile,
+                                const bool &encoded);
+
+    static void apply_settings(QNetworkRequest &request, const QVariantHash &settings);
     void throttle_settings();
-    static int validate_user(const QString &user);
+    void select_route(const int &index);
+    void build_routes();
+    void release_routes();
+    QNetworkAccessManager* route_manager();
+    const QNetworkRequest& profile_request(const int &profile, const bool &encoded);
+    QString set_session(QNetworkRequest &request, const QUrl &link);
+    void set_reply(QNetworkReply *reply, const QString &session, const int &timeout);
+    NetworkFuture* queue_request(NetworkFuture *future,
+                                 const QNetworkAccessManager::Operation &operation,
+                                 const QUrl &link,
+                                 const QUrlQuery &get_parameters,
+                                 const QByteArray &body,
+                                 const int &timeout,
+                                 const int &profile,
+                                 const QVariantHash &temp_settings = QVariantHash());
+
+    struct UserSettings;
+    const UserSettings* find_user(const QString &user) const;
+    void refresh_snapshot() const;
+    static QString route_key(const QString &user, const QNetworkProxy &proxy);
+    static QUrl redirect(QUrl link);
+    static QNetworkProxy resolve_proxy(QNetworkProxy proxy);
+
+public_enums:
+    enum phases
+    {
+        phase_queue = 0,
+        phase_connect = 1,
+        phase_first_byte = 2,
+        phase_download = 3,
+        phase_total = 4,
+        phases_size = 5
+    };
+
+public_members:
+    static const int timeout_auto = -1;
+    static const int profile_default = -1;
 
 private_members:
     static QMutex mutex;
     QStringList users;
+    bool coalescing;
+    bool caching;
+    int coalesced_count;
+    double timeout_factor;
+    int timeout_minimum;
+    int timeout_maximum;
 
 private_data_members:
+    struct UserSettings
+    {
+        QNetworkRequest request;
+        QList<QNetworkProxy> proxys;
+        CookieSet cookies;
+    };
+
     QString current_manager;
     QNetworkProxy proxy_manager;
     QNetworkRequest request_manager;
+    QVector<QVariantHash> profile_settings;
+    QHash<QString, QVector<QNetworkRequest> > profile_requests;
     PersistentCookieJar *cookies_manager;
+    TimerWheel *timer_wheel;
+    QNetworkAccessManager *route_current;
+    QString route_current_key;
+    QHash<QString, QNetworkAccessManager*> route_managers;
+    QList<QNetworkAccessManager*> route_retired;
+    QHash<QString, LatencyHistogram> route_latency;
+    QHash<QString, QVector<LatencyHistogram> > route_phases;
+    QHash<QString, NetworkFuture*> coalesced_requests;
+    QElapsedTimer route_clock;
+
+    struct QueuedRequest
+    {
+        QPointer<NetworkFuture> future;
+        QNetworkAccessManager::Operation operation;
+        QUrl link;
+        QUrlQuery get_parameters;
+        QByteArray body;
+        int timeout;
+        int profile;
+        QVariantHash temp_settings;
+        qint64 queued;
+    };
+
+    RequestLimiter request_limiter;
+    QList<QueuedRequest> queued_requests;
+    QTimer *dispatch_timer;
+
+    struct Route
+    {
+        int user;
+        int proxy;
+        QString key;
+        const UserSettings *settings;
+        QNetworkAccessManager *manager;
+    };
+
+    QVector<Route> routes;
+    int route_index;
+    int route_user;
+    int routes_generation;
+    int dns_generation;
+
+    mutable int snapshot_generation;
+    mutable QHash<QString, UserSettings> snapshot_settings;
+
+    static QAtomicInt settings_generation;
+    static QHash<QString, UserSettings> user_settings;
+    static QUrl endpoint;
 
-    static QList<QString> user_settings;
-    static QList<QNetworkRequest> request_settings;
-    static QList<QList<QNetworkProxy> > proxy_settings;
-    static QList<QList<QNetworkCookie> > cookies_settings;
+private slots:
+    void reply_finished(QNetworkReply *reply);
+    void reply_encrypted(QNetworkReply *reply);
+    void reply_headers();
+    void coalesced_finished(NetworkFuture *leader);
+    void dispatch_requests();
 
 };
 
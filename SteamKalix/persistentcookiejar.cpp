@@ -18,6 +18,21 @@
 
 #include "persistentcookiejar.h"
 
+/**
+ *@brief Anonymous namespace
+ *      This namespace is used as a "private section".
+ *      It is anonymous and therefore can only accessed within file scope.
+ *@remarks Variables
+ *      The flush interval is shared by all the jars, 0 disables the background saves.
+ *@date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+namespace
+{
+    QAtomicInt flush_interval(5000);
+}
+
 /**
  * @brief PersistentCookieJar::PersistentCookieJar
  *      Initializes members.
@@ -25,25 +40,30 @@
  *      Chooses if the class should save the cookies on destruction.
  * @date
  *      Created:  Filipe, 6 Mar 2014
- *      Modified: Filipe, 9 Mar 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
-PersistentCookieJar::PersistentCookieJar(bool autosave)
+PersistentCookieJar::PersistentCookieJar(bool autosave) :
+    flush_timer(new QTimer(this))
 {
     this->autosave = autosave;
     this->name = "";
+    this->dirty = false;
+
+    flush_timer->setSingleShot(true);
+    connect(flush_timer, SIGNAL(timeout()), this, SLOT(flush()));
 }
 
 /**
  * @brief PersistentCookieJar::~PersistentCookieJar
- *      If enabled, saves current cookies.
+ *      If enabled or if there are changes not flushed, saves current cookies.
  *      There are no resources to delete.
  * @date
  *      Created:  Filipe, 6 Mar 2014
- *      Modified: Filipe, 9 Mar 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
 PersistentCookieJar::~PersistentCookieJar()
 {
-    if(autosave)
+    if(autosave || dirty)
     {
         save();
     }
@@ -58,20 +78,45 @@ PersistentCookieJar::~PersistentCookieJar()
  *      Flags if the current cookies are to be cleared.
  * @return
  *      The number of loaded cookies.
+ * @remarks
+ *      The cookies are read from the CookieJournal. The cookies of a user still in the settings are moved to it.
+ *      The changes of the previous user are flushed and the queued saves are written first.
  * @date
  *      Created:  Filipe, 6 Mar 2014
- *      Modified: Filipe, 15 Apr 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
 int PersistentCookieJar::load(const QString &name, bool clear_oookies)
 {
+    flush();
+    CookieJournal::wait();
+
     this->name = name;
 
-    QByteArray cookie_storage = SettingsManager::read("Cookies/" + name).toByteArray();
-    QList<QNetworkCookie> cookie_list = QNetworkCookie::parseCookies(cookie_storage);
+    QList<QNetworkCookie> cookie_list;
+
+    if(CookieJournal::contains(name))
+    {
+        cookie_list = CookieJournal::load(name);
+    }
+    else
+    {
+        //Cookies saved to the settings by older versions are moved to the journal
+        QByteArray cookie_storage = SettingsManager::read("Cookies/" + name).toByteArray();
+        cookie_list = QNetworkCookie::parseCookies(cookie_storage);
+
+        if(!cookie_list.isEmpty() && CookieJournal::save(name, cookie_list))
+        {
+            SettingsManager::remove("Cookies/" + name);
+        }
+    }
 
     if(clear_oookies)
     {
-        setAllCookies(cookie_list);
+        set_all_cookies(cookie_list);
+
+        //The loaded cookies are already saved
+        flush_timer->stop();
+        dirty = false;
     }
     else
     {
@@ -89,27 +134,24 @@ int PersistentCookieJar::load(const QString &name, bool clear_oookies)
  *      Saves all the current cookies if the user is already set.
  * @return
  *      True if saved, false if not.
+ * @remarks
+ *      Only the cookies that changed since the last save are written, see CookieJournal::save.
+ *      The save is immediate, the queued saves are written first so an older one does not overwrite it.
  * @date
  *      Created:  Filipe, 6 Mar 2014
- *      Modified: Filipe, 9 Mar 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
-bool PersistentCookieJar::save() const
+bool PersistentCookieJar::save()
 {
     bool result = false;
 
+    flush_timer->stop();
+    dirty = false;
+
     if(name != "")
     {
-        QList<QNetworkCookie> cookie_list = allCookies();
-        QByteArray cookie_storage;
-
-        for(int i = 0; i < cookie_list.size(); i++)
-        {
-            cookie_storage.append(cookie_list[i].toRawForm() + "\n");
-        }
-
-        SettingsManager::write("Cookies/" + name, cookie_storage);
-
-        result = true;
+        CookieJournal::wait();
+        result = CookieJournal::save(name, cookie_set.all_cookies());
     }
 
     return result;
@@ -117,15 +159,15 @@ bool PersistentCookieJar::save() const
 
 /**
  * @brief PersistentCookieJar::clear
- *      Clears all the cookies by loading an empty cookie list.
+ *      Clears all the cookies by clearing the set.
  * @date
  *      Created:  Filipe, 6 Mar 2014
- *      Modified: Filipe, 6 Mar 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
 void PersistentCookieJar::clear()
 {
-    QList<QNetworkCookie> cookie_list;
-    setAllCookies(cookie_list);
+    cookie_set.clear();
+    changed();
 }
 
 /**
@@ -133,48 +175,31 @@ void PersistentCookieJar::clear()
  *      Clears all the cookies except the ones passed on the list.
  * @param exclude
  *      The list of cookies that cannot be deleted.
+ *      A cookie is kept if its name starts with one of them, e.g. "steamMachineAuth" keeps "steamMachineAuth<steamid>".
+ * @remarks
+ *      The cookies are removed in place, see CookieSet::remove_except.
  * @date
  *      Created:  Filipe, 15 Apr 2014
- *      Modified: Filipe, 15 Apr 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
 void PersistentCookieJar::clear(const QStringList &exclude)
 {
-    QList<QNetworkCookie> cookie_list = allCookies();
-    bool found = false;
-
-    for(int i = 0; i < cookie_list.size(); i++)
-    {
-        for(int j = 0; j < exclude.length(); j++)
-        {
-            if(cookie_list.at(i).name().contains(exclude.at(j).toUtf8()))
-            {
-                found = true;
-                break;
-            }
-        }
-
-        if(!found)
-        {
-            deleteCookie(cookie_list.at(i));
-        }
-
-        found = false;
-    }
+    cookie_set.remove_except(exclude);
+    changed();
 }
 
 /**
  * @brief PersistentCookieJar::count
- *      Returns the number of cookies currently set.
+ *      Returns the number of cookies currently set. The count is kept by the set.
  * @return
  *      The number of cookies.
  * @date
  *      Created:  Filipe, 5 Set 2014
- *      Modified: Filipe, 5 Set 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
-int PersistentCookieJar::count()
+int PersistentCookieJar::count() const
 {
-    QList<QNetworkCookie> cookie_list = allCookies();
-    return cookie_list.size();
+    return cookie_set.count();
 }
 
 /**
@@ -184,31 +209,59 @@ int PersistentCookieJar::count()
  *      This is done because the function setAllCookies() is protected in the base class.
  *      Therefore, it can only be access by this derived class.
  * @param cookies_list
- *      List with all the cookies.
+ *      List with all the cookies, it replaces the set.
  * @date
  *      Created:  Filipe, 23 Mar 2014
- *      Modified: Filipe, 23 Mar 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
 void PersistentCookieJar::set_all_cookies(const QList<QNetworkCookie> &cookies_list)
 {
-    setAllCookies(cookies_list);
+    cookie_set = CookieSet(cookies_list);
+    changed();
 }
 
 /**
  * @brief PersistentCookieJar::all_cookies
  *      Gives access to all the cookies.
  * @remarks
- *      This is done because the function allCookies() is protected in the base class.
- *      Therefore, it can only be access by this derived class.
+ *      The cookies are kept in the CookieSet of this class, not in the base class.
+ *      This builds the list, use it only to store the cookies (e.g. NetworkManager::save_settings).
  * @return
  *      List with all the cookies.
  * @date
  *      Created:  Filipe, 6 Mar 2014
- *      Modified: Filipe, 6 Mar 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
 QList<QNetworkCookie> PersistentCookieJar::all_cookies() const
 {
-    return allCookies();
+    return cookie_set.all_cookies();
+}
+
+/**
+ * @brief PersistentCookieJar::set_cookies
+ * @brief PersistentCookieJar::cookies
+ *      Gives access to the set of cookies. The set is implicitly shared, no cookie is copied.
+ * @param cookies
+ *      The set, it replaces the current one.
+ *      The set belongs to the registry of the NetworkManager, the changes of the current user are flushed and the jar
+ *      is no longer saved (until load).
+ * @return
+ *      The set of cookies.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void PersistentCookieJar::set_cookies(const CookieSet &cookies)
+{
+    flush();
+
+    cookie_set = cookies;
+    name = "";
+}
+
+CookieSet PersistentCookieJar::cookies() const
+{
+    return cookie_set;
 }
 
 /**
@@ -219,17 +272,130 @@ QList<QNetworkCookie> PersistentCookieJar::all_cookies() const
  *      Data to be displayed
  * @date
  *      Created:  Filipe, 6 Mar 2014
- *      Modified: Filipe, 7 Mar 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
 QByteArray PersistentCookieJar::print() const
 {
-    QList<QNetworkCookie> cookie_list = allCookies();
-    QByteArray cookie_storage;
+    return cookie_set.raw_form("<p>", "</p>");
+}
+
+/**
+ * @brief PersistentCookieJar::cookiesForUrl
+ * @brief PersistentCookieJar::insertCookie
+ * @brief PersistentCookieJar::deleteCookie
+ *      Reimplements the storage of the base class with the CookieSet.
+ *      The lookups visit only the domains of the host and are memoized, see CookieSet::cookies_for_url.
+ *      insertCookie is called by setCookiesFromUrl, after the cookie was validated by the base class.
+ *      An expired cookie is a deletion, it goes through deleteCookie.
+ *      The changes, deletions included, start the flush timer.
+ * @param url
+ *      URL of the request.
+ * @param cookie
+ *      The cookie to insert or delete.
+ * @return
+ *      The cookies to be sent. True if the cookie was inserted or deleted.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+QList<QNetworkCookie> PersistentCookieJar::cookiesForUrl(const QUrl &url) const
+{
+    return cookie_set.cookies_for_url(url);
+}
+
+bool PersistentCookieJar::insertCookie(const QNetworkCookie &cookie)
+{
+    //An expired cookie deletes the stored one (logout, session rotation), like the base class
+    if(!cookie.isSessionCookie() && cookie.expirationDate() < QDateTime::currentDateTimeUtc())
+    {
+        deleteCookie(cookie);
+        return false;
+    }
+
+    bool result = cookie_set.insert(cookie);
+
+    if(result)
+    {
+        changed();
+    }
+
+    return result;
+}
+
+bool PersistentCookieJar::deleteCookie(const QNetworkCookie &cookie)
+{
+    bool result = cookie_set.remove(cookie);
+
+    if(result)
+    {
+        changed();
+    }
+
+    return result;
+}
+
+/**
+ * @brief PersistentCookieJar::set_flush_interval
+ * @brief PersistentCookieJar::get_flush_interval
+ *      Time between the first change and the background save, the same for all the jars.
+ * @param msecs
+ *      The interval in milliseconds, 0 disables the background saves (only save writes the cookies).
+ * @return
+ *      The interval in milliseconds.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void PersistentCookieJar::set_flush_interval(const int &msecs)
+{
+    flush_interval.store(qMax(0, msecs));
+}
+
+int PersistentCookieJar::get_flush_interval()
+{
+    return flush_interval.load();
+}
+
+/**
+ * @brief PersistentCookieJar::changed
+ *      Marks the cookies as changed and starts the flush timer, if it is not running.
+ *      The timer is not restarted by the changes that follow, they are saved together when it expires.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void PersistentCookieJar::changed()
+{
+    int interval = flush_interval.load();
+
+    if(interval > 0 && name != "")
+    {
+        dirty = true;
+
+        if(!flush_timer->isActive())
+        {
+            flush_timer->start(interval);
+        }
+    }
+}
+
+/**
+ * @brief PersistentCookieJar::flush
+ *      Queues a background save of the cookies, if they changed since the last save.
+ * @remarks
+ *      The save gets a copy of the set (implicitly shared), the changes that follow detach the jar from it.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void PersistentCookieJar::flush()
+{
+    flush_timer->stop();
 
-    for(int i = 0; i < cookie_list.size(); i++)
+    if(dirty && name != "")
     {
-        cookie_storage.append("<p>" + cookie_list[i].toRawForm()+ "</p>");
+        CookieJournal::save_later(name, cookie_set);
     }
 
-    return cookie_storage;
+    dirty = false;
 }
@@ -21,20 +21,35 @@
 
 #include <QNetworkCookie>
 #include <QNetworkCookieJar>
+#include <QAtomicInt>
+#include <QTimer>
 
 #include "defines.h"
 #include "settingsmanager.h"
+#include "cookieset.h"
+#include "cookiejournal.h"
 
 /**
  * @brief The PersistentCookieJar class
  *      This class derives from "QNetworkCookieJar" in order to implement a presistent way to store and handle cookies.
  *      This class has no parent. It is supposed to be used with the function 'setCookieJar' which will take the ownership of this object.
+ * @remarks
+ *      The cookies are kept in a CookieSet (indexed by domain), instead of the flat list of the base class.
+ *      A lookup only visits the domains of the host (e.g. "store.steampowered.com" and "steampowered.com"),
+ *      the count is kept and the read paths (count, print, save) do not copy the cookies.
+ * @remarks
+ *      The cookies are stored in the binary CookieJournal, not in the settings file.
+ * @remarks
+ *      The changes are tracked, the first change starts the flush timer and the cookies are saved in the background
+ *      when it expires (see set_flush_interval). The changes in between are saved together, a crash loses one interval at most.
+ *      A jar without a user (set_cookies) is not saved.
  * @date
  *      Created:  Filipe, 6 Mar 2014
- *      Modified: Filipe, 15 Apr 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
 class PersistentCookieJar : public QNetworkCookieJar
 {
+    Q_OBJECT
 
 public_construct:
     PersistentCookieJar(bool autosave = false);
@@ -42,18 +57,38 @@ public_construct:
 
 public_methods:
     int load(const QString &name, bool clear_oookies = false);
-    bool save() const;
+    bool save();
     void clear();
     void clear(const QStringList &exclude);
-    int count();
+    int count() const;
 
     void set_all_cookies(const QList<QNetworkCookie> &cookies_list);
     QList<QNetworkCookie> all_cookies() const;
+    void set_cookies(const CookieSet &cookies);
+    CookieSet cookies() const;
     QByteArray print() const;
 
+    QList<QNetworkCookie> cookiesForUrl(const QUrl &url) const;
+    bool insertCookie(const QNetworkCookie &cookie);
+    bool deleteCookie(const QNetworkCookie &cookie);
+
+    static void set_flush_interval(const int &msecs);
+    static int get_flush_interval();
+
+private_methods:
+    void changed();
+
 private_members:
     QString name;
     bool autosave;
+    bool dirty;
+
+private_data_members:
+    CookieSet cookie_set;
+    QTimer *flush_timer;
+
+private slots:
+    void flush();
 
 };
 
@@ -0,0 +1,154 @@
+/*
+ * SteamKalix
+ * Copyright (C) 2014 Filipe Carvalho
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "postbody.h"
+
+/**
+ * @brief PostBody::PostBody
+ *      Initializes an empty body.
+ * @remarks
+ *      The first segment holds the static fields before the first slot,
+ *      there is always one segment more than the number of slots.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+PostBody::PostBody() :
+    changed(true),
+    segments(1)
+{
+}
+
+/**
+ * @brief PostBody::add_field
+ *      Adds a static field, it is encoded now.
+ * @param name
+ *      Name of the field.
+ * @param value
+ *      Value of the field.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void PostBody::add_field(const QString &name, const QString &value)
+{
+    QByteArray &segment = segments.last();
+
+    if(!segment.isEmpty() || segments.size() > 1)
+    {
+        segment.append('&');
+    }
+
+    segment.append(QUrl::toPercentEncoding(name));
+    segment.append('=');
+    segment.append(QUrl::toPercentEncoding(value));
+    changed = true;
+}
+
+/**
+ * @brief PostBody::add_slot
+ *      Adds a variable field, its value is set with set().
+ * @param name
+ *      Name of the field.
+ * @return
+ *      The slot of the field.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+int PostBody::add_slot(const QString &name)
+{
+    QByteArray &segment = segments.last();
+
+    if(!segment.isEmpty() || segments.size() > 1)
+    {
+        segment.append('&');
+    }
+
+    segment.append(QUrl::toPercentEncoding(name));
+    segment.append('=');
+
+    segments.append(QByteArray());
+    slots_values.append(QByteArray());
+    changed = true;
+
+    return slots_values.size() - 1;
+}
+
+/**
+ * @brief PostBody::set
+ *      Sets the value of a slot.
+ *      The number version does not need any encoding, use it for prices and ids.
+ * @param slot
+ *      The slot from add_slot.
+ * @param value
+ * @param number
+ *      The new value.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void PostBody::set(const int &slot, const QString &value)
+{
+    slots_values[slot] = QUrl::toPercentEncoding(value);
+    changed = true;
+}
+
+void PostBody::set(const int &slot, const qint64 &number)
+{
+    slots_values[slot].setNum(number);
+    changed = true;
+}
+
+/**
+ * @brief PostBody::data
+ *      Builds the body, only if a field or slot changed since the last call.
+ * @return
+ *      The encoded body.
+ * @remarks
+ *      The buffer keeps its capacity, so the next builds do not allocate (unless it is still shared by a request).
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+const QByteArray& PostBody::data() const
+{
+    if(changed)
+    {
+        int size = 0;
+        for(int i = 0; i < slots_values.size(); i++)
+        {
+            size += segments.at(i).size() + slots_values.at(i).size();
+        }
+        size += segments.last().size();
+
+        buffer.reserve(size);
+        buffer.resize(0);
+
+        for(int i = 0; i < slots_values.size(); i++)
+        {
+            buffer.append(segments.at(i));
+            buffer.append(slots_values.at(i));
+        }
+        buffer.append(segments.last());
+
+        changed = false;
+    }
+
+    return buffer;
+}
@@ -0,0 +1,69 @@
+/*
+ * SteamKalix
+ * Copyright (C) 2014 Filipe Carvalho
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef POSTBODY_H
+#define POSTBODY_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+#include <QUrl>
+
+#include "defines.h"
+
+/**
+ * @brief The PostBody class
+ *      Body of a POST request (application/x-www-form-urlencoded) that is built once and reused.
+ *      The static fields are encoded when they are added, the variable fields (e.g. price, listing id)
+ *      are slots that are patched before each request. Building the body is a few copies into a reused buffer,
+ *      without converting or encoding the static fields again.
+ * @remarks Path of execution
+ *      Add the fields in order with add_field (static) and add_slot (variable), once.
+ *      For each request, set the slots and pass the body to postHTTP.
+ * @remarks
+ *      The buffer sent with a request is implicitly shared, setting a slot while it is in flight makes one copy.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+class PostBody
+{
+
+public_construct:
+    PostBody();
+
+public_methods:
+    void add_field(const QString &name, const QString &value);
+    int add_slot(const QString &name);
+
+    void set(const int &slot, const QString &value);
+    void set(const int &slot, const qint64 &number);
+
+    const QByteArray& data() const;
+
+private_members:
+    mutable bool changed;
+
+private_data_members:
+    QVector<QByteArray> segments;
+    QVector<QByteArray> slots_values;
+    mutable QByteArray buffer;
+
+};
+
+#endif // POSTBODY_H
@@ -0,0 +1,300 @@
+/*
+ * SteamKalix
+ * Copyright (C) 2014 Filipe Carvalho
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "requestlimiter.h"
+
+#include <QDateTime>
+#include <QLocale>
+
+/**
+ *@brief Anonymous namespace
+ *      This namespace is used as a "private section".
+ *      It is anonymous and therefore can only accessed within file scope.
+ *@remarks Variables
+ *      The backoff without Retry-After starts at 1 second and doubles up to 1 minute.
+ *      After a 429 or 503 the rate is halved, down to rate_minimum, each success adds rate_step of the limit.
+ *@date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+namespace
+{
+    const int backoff_minimum = 1000;
+    const int backoff_maximum = 60000;
+    const double rate_minimum = 0.1;
+    const double rate_step = 0.05;
+}
+
+/**
+ * @brief RequestLimiter::HostState::HostState
+ *      Initializes the state of a host, nothing in flight and a full bucket.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+RequestLimiter::HostState::HostState() :
+    in_flight(0),
+    tokens(-1),
+    rate(-1),
+    refilled(0),
+    blocked_until(0),
+    backoff(0)
+{
+}
+
+/**
+ * @brief RequestLimiter::RequestLimiter
+ *      Initializes the limiter with all the limits disabled.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+RequestLimiter::RequestLimiter() :
+    host_limit(0),
+    route_limit(0),
+    rate_limit(0),
+    burst(1),
+    throttled(0)
+{
+    clock.start();
+}
+
+/**
+ * @brief RequestLimiter::set_limits
+ *      Sets the limits of the requests.
+ * @param host_limit
+ *      Maximum requests in flight for each host.
+ * @param route_limit
+ *      Maximum requests in flight for each route (user and proxy).
+ * @param rate
+ *      Maximum requests per second for each host.
+ * @param burst
+ *      Requests that can be made at once, when a host was idle (size of the bucket).
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void RequestLimiter::set_limits(const int &host_limit, const int &route_limit, const double &rate, const int &burst)
+{
+    this->host_limit = qMax(0, host_limit);
+    this->route_limit = qMax(0, route_limit);
+    this->rate_limit = qMax(0.0, rate);
+    this->burst = qMax(1, burst);
+
+    //The hosts start over with the new rate
+    QHash<QString, HostState>::iterator it;
+    for(it = hosts.begin(); it != hosts.end(); ++it)
+    {
+        it->tokens = -1;
+        it->rate = -1;
+    }
+}
+
+/**
+ * @brief RequestLimiter::is_enabled
+ *      True if any limit is set. Requests can still wait for a Retry-After without limits.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+bool RequestLimiter::is_enabled() const
+{
+    return host_limit > 0 || route_limit > 0 || rate_limit > 0;
+}
+
+/**
+ * @brief RequestLimiter::wait
+ *      Verifies if a request to a host, on a route, can be made now.
+ * @param host
+ *      Host of the request.
+ * @param route
+ *      Key of the route.
+ * @return
+ *      0 if the request can be made now.
+ *      -1 if a concurrency limit is full, the request has to wait for another one to finish.
+ *      Otherwise, the time in milliseconds until the host accepts the request (rate or Retry-After).
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+int RequestLimiter::wait(const QString &host, const QString &route)
+{
+    qint64 now = clock.elapsed();
+    HostState &state = hosts[host];
+
+    if(state.blocked_until > now)
+    {
+        return static_cast<int>(state.blocked_until - now);
+    }
+
+    if((host_limit > 0 && state.in_flight >= host_limit) ||
+       (route_limit > 0 && routes_in_flight.value(route) >= route_limit))
+    {
+        return -1;
+    }
+
+    if(rate_limit > 0)
+    {
+        refill(state, now);
+
+        if(state.tokens < 1)
+        {
+            return qMax(1, static_cast<int>((1 - state.tokens) * 1000 / state.rate));
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief RequestLimiter::acquire
+ *      Counts a request that was made. Requests made without asking (wait) are also counted.
+ * @param host
+ *      Host of the request.
+ * @param route
+ *      Key of the route.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void RequestLimiter::acquire(const QString &host, const QString &route)
+{
+    HostState &state = hosts[host];
+    state.in_flight++;
+    routes_in_flight[route]++;
+
+    if(rate_limit > 0)
+    {
+        refill(state, clock.elapsed());
+        state.tokens -= 1;
+    }
+}
+
+/**
+ * @brief RequestLimiter::release
+ *      Counts a request that finished, and reacts to the back-pressure of the server.
+ * @param host
+ *      Host of the request.
+ * @param route
+ *      Key of the route.
+ * @param status
+ *      HTTP status of the reply, 0 without reply.
+ * @param retry_after
+ *      The Retry-After header, in seconds or an HTTP date. Empty if there is none.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void RequestLimiter::release(const QString &host, const QString &route, const int &status, const QByteArray &retry_after)
+{
+    qint64 now = clock.elapsed();
+    HostState &state = hosts[host];
+    state.in_flight = qMax(0, state.in_flight - 1);
+
+    int &route_in_flight = routes_in_flight[route];
+    route_in_flight = qMax(0, route_in_flight - 1);
+
+    if(status == 429 || status == 503)
+    {
+        throttled++;
+
+        //Retry-After in seconds, or as a date
+        bool seconds_ok = false;
+        qint64 delay = retry_after.trimmed().toLongLong(&seconds_ok) * 1000;
+
+        if(!seconds_ok && !retry_after.isEmpty())
+        {
+            QDateTime date = QLocale::c().toDateTime(QString::fromLatin1(retry_after.trimmed()), "ddd, dd MMM yyyy hh:mm:ss 'GMT'");
+            date.setTimeSpec(Qt::UTC);
+            delay = date.isValid() ? QDateTime::currentDateTimeUtc().msecsTo(date) : 0;
+        }
+
+        if(delay <= 0)
+        {
+            state.backoff = qBound(backoff_minimum, state.backoff * 2, backoff_maximum);
+            delay = state.backoff;
+        }
+
+        state.blocked_until = qMax(state.blocked_until, now + delay);
+
+        if(rate_limit > 0)
+        {
+            refill(state, now);
+            state.rate = qMax(rate_minimum, state.rate / 2);
+        }
+    }
+    else if(status > 0)
+    {
+        state.backoff = 0;
+
+        if(rate_limit > 0 && state.rate >= 0)
+        {
+            state.rate = qMin(rate_limit, state.rate + rate_limit * rate_step);
+        }
+    }
+}
+
+/**
+ * @brief RequestLimiter::refill
+ *      Adds the tokens of the time since the last refill.
+ * @param state
+ *      The host.
+ * @param now
+ *      Current time of the clock.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void RequestLimiter::refill(HostState &state, const qint64 &now) const
+{
+    if(state.rate < 0)
+    {
+        state.rate = rate_limit;
+        state.tokens = burst;
+    }
+    else
+    {
+        state.tokens = qMin(static_cast<double>(burst), state.tokens + (now - state.refilled) * state.rate / 1000.0);
+    }
+
+    state.refilled = now;
+}
+
+/**
+ * @brief RequestLimiter::print
+ *      Creates a string with the state of the limiter.
+ *      Use and output method that supports HTML.
+ * @return
+ *      Data to be displayed
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+QString RequestLimiter::print() const
+{
+    int in_flight = 0;
+
+    QHash<QString, HostState>::const_iterator it;
+    for(it = hosts.constBegin(); it != hosts.constEnd(); ++it)
+    {
+        in_flight += it->in_flight;
+    }
+
+    return "In flight: " + QString::number(in_flight) +
+           " - Throttled (429/503): " + QString::number(throttled);
+}
@@ -0,0 +1,89 @@
+/*
+ * SteamKalix
+ * Copyright (C) 2014 Filipe Carvalho
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef REQUESTLIMITER_H
+#define REQUESTLIMITER_H
+
+#include <QString>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QHash>
+
+#include "defines.h"
+
+/**
+ * @brief The RequestLimiter class
+ *      Back-pressure of the requests of a network manager.
+ *      Limits the requests in flight per host and per route, and the rate per host with a token bucket.
+ *      A 429 (Too Many Requests) or 503 (Service Unavailable) blocks the host for the time in Retry-After,
+ *      or an exponential backoff without it, and halves the rate. Each success raises it back slowly.
+ * @remarks
+ *      The limiter only decides, the network manager queues the requests that have to wait.
+ *      A limit of 0 disables that limit. All limits are disabled by default.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+class RequestLimiter
+{
+
+public_construct:
+    RequestLimiter();
+
+public_methods:
+    void set_limits(const int &host_limit, const int &route_limit, const double &rate, const int &burst);
+    bool is_enabled() const;
+
+    int wait(const QString &host, const QString &route);
+    void acquire(const QString &host, const QString &route);
+    void release(const QString &host, const QString &route, const int &status, const QByteArray &retry_after);
+
+    QString print() const;
+
+private_methods:
+    struct HostState;
+    void refill(HostState &state, const qint64 &now) const;
+
+private_members:
+    int host_limit;
+    int route_limit;
+    double rate_limit;
+    int burst;
+
+    int throttled;
+
+private_data_members:
+    struct HostState
+    {
+        HostState();
+
+        int in_flight;
+        double tokens;
+        double rate;
+        qint64 refilled;
+        qint64 blocked_until;
+        int backoff;
+    };
+
+    QElapsedTimer clock;
+    QHash<QString, HostState> hosts;
+    QHash<QString, int> routes_in_flight;
+
+};
+
+#endif // REQUESTLIMITER_H
@@ -0,0 +1,491 @@
+/*
+ * SteamKalix
+ * Copyright (C) 2014 Filipe Carvalho
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "responsecache.h"
+
+/**
+ *@brief Anonymous namespace
+ *      This namespace is used as a "private section".
+ *      It is anonymous and therefore can only accessed within file scope.
+ *@remarks Variables
+ *      Entries are kept in a hash by partition and URL (entry_key).
+ *      The entries are also linked by use, each one has the keys of the next newer and older entries,
+ *      so a lookup moves it to the front in O(1) and the oldest entry is evicted first.
+ *      The entries are stored already expired (revalidate_date). Otherwise Qt serves the ones it considers fresh
+ *      (max-age, Expires or 10% of the age of Last-Modified) without a request, every hit must be a conditional request.
+ *@date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+namespace
+{
+    struct Entry
+    {
+        QNetworkCacheMetaData metadata;
+        QByteArray body;
+        QString newer;
+        QString older;
+    };
+
+    QMutex mutex;
+    QHash<QString, Entry> entries;
+    QString newest;
+    QString oldest;
+    qint64 size = 0;
+    qint64 maximum_size = 16 * 1024 * 1024;
+    const QDateTime revalidate_date(QDate(1970, 1, 1), QTime(0, 0), Qt::UTC);
+    QAtomicInt hits(0);
+
+    void unlink(Entry &entry)
+    {
+        if(entry.newer.isEmpty())
+        {
+            newest = entry.older;
+        }
+        else
+        {
+            entries[entry.newer].older = entry.older;
+        }
+
+        if(entry.older.isEmpty())
+        {
+            oldest = entry.newer;
+        }
+        else
+        {
+            entries[entry.older].newer = entry.newer;
+        }
+
+        entry.newer.clear();
+        entry.older.clear();
+    }
+
+    void link(const QString &key, Entry &entry)
+    {
+        entry.older = newest;
+
+        if(newest.isEmpty())
+        {
+            oldest = key;
+        }
+        else
+        {
+            entries[newest].newer = key;
+        }
+
+        newest = key;
+    }
+
+    void touch(const QString &key, Entry &entry)
+    {
+        if(newest != key)
+        {
+            unlink(entry);
+            link(key, entry);
+        }
+    }
+
+    void erase(const QString &key)
+    {
+        QHash<QString, Entry>::iterator it = entries.find(key);
+
+        if(it != entries.end())
+        {
+            size -= it->body.size();
+            unlink(*it);
+            entries.erase(it);
+        }
+    }
+
+    void evict()
+    {
+        while(size > maximum_size && !oldest.isEmpty())
+        {
+            erase(oldest);
+        }
+    }
+}
+
+/**
+ * @brief ResponseCache::ResponseCache
+ *      Creates a cache for an access manager.
+ * @param partition
+ *      The network user of the access manager, the entries are only shared within the same partition.
+ * @param parent
+ *      The access manager, it takes ownership with setCache.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+ResponseCache::ResponseCache(const QString &partition, QObject *parent) :
+    QAbstractNetworkCache(parent),
+    partition(partition)
+{
+}
+
+/**
+ * @brief ResponseCache::~ResponseCache
+ *      Deletes the responses that were still being received.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+ResponseCache::~ResponseCache()
+{
+    qDeleteAll(inserting.keys());
+}
+
+/**
+ * @brief ResponseCache::metaData
+ *      Gets the headers of a response. The access manager uses them for the conditional request.
+ * @param url
+ *      URL of the request.
+ * @return
+ *      The stored headers, invalid if the URL is not cached.
+ * @remarks
+ *      This function should be thread-safe.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+QNetworkCacheMetaData ResponseCache::metaData(const QUrl &url)
+{
+    mutex.lock();
+    QNetworkCacheMetaData metadata = entries.value(entry_key(url)).metadata;
+    mutex.unlock();
+
+    return metadata;
+}
+
+/**
+ * @brief ResponseCache::updateMetaData
+ *      Replaces the headers of a response, after a 304.
+ *      If the new headers can no longer be stored (see prepare), the response is removed.
+ *      The expiration Qt computed from the headers is replaced, the response stays expired.
+ * @param metaData
+ *      The new headers.
+ * @remarks
+ *      This function should be thread-safe.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void ResponseCache::updateMetaData(const QNetworkCacheMetaData &metaData)
+{
+    QString key = entry_key(metaData.url());
+
+    mutex.lock();
+    if(!is_storable(metaData))
+    {
+        erase(key);
+    }
+    else
+    {
+        QHash<QString, Entry>::iterator it = entries.find(key);
+
+        if(it != entries.end())
+        {
+            it->metadata = metaData;
+            it->metadata.setExpirationDate(revalidate_date);
+        }
+    }
+    mutex.unlock();
+}
+
+/**
+ * @brief ResponseCache::data
+ *      Gets the body of a response, served after a 304.
+ * @param url
+ *      URL of the request.
+ * @return
+ *      A device with the body, the caller takes ownership. NULL if the URL is not cached.
+ * @remarks
+ *      The body is implicitly shared, it is not copied.
+ *      This function should be thread-safe.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+QIODevice* ResponseCache::data(const QUrl &url)
+{
+    QBuffer *buffer = NULL;
+    QString key = entry_key(url);
+
+    mutex.lock();
+    QHash<QString, Entry>::iterator it = entries.find(key);
+
+    if(it != entries.end())
+    {
+        touch(key, *it);
+        hits.ref();
+
+        buffer = new QBuffer();
+        buffer->setData(it->body);
+        buffer->open(QIODevice::ReadOnly);
+    }
+    mutex.unlock();
+
+    return buffer;
+}
+
+/**
+ * @brief ResponseCache::remove
+ *      Removes a response, and the response being received for the same URL.
+ * @param url
+ *      URL of the request.
+ * @return
+ *      True if something was removed.
+ * @remarks
+ *      This function should be thread-safe.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+bool ResponseCache::remove(const QUrl &url)
+{
+    bool removed = false;
+
+    QHash<QIODevice*, QNetworkCacheMetaData>::iterator it = inserting.begin();
+    while(it != inserting.end())
+    {
+        if(it.value().url() == url)
+        {
+            delete it.key();
+            it = inserting.erase(it);
+            removed = true;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    QString key = entry_key(url);
+
+    mutex.lock();
+    if(entries.contains(key))
+    {
+        erase(key);
+        removed = true;
+    }
+    mutex.unlock();
+
+    return removed;
+}
+
+/**
+ * @brief ResponseCache::cacheSize
+ *      Size of all the bodies in the cache, in bytes.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+qint64 ResponseCache::cacheSize() const
+{
+    mutex.lock();
+    qint64 cache_size = size;
+    mutex.unlock();
+
+    return cache_size;
+}
+
+/**
+ * @brief ResponseCache::prepare
+ *      Creates the device where the access manager writes a response while it is received.
+ * @param metaData
+ *      Headers of the response.
+ * @return
+ *      The device, kept until insert or remove. NULL if the response cannot be stored (see is_storable).
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+QIODevice* ResponseCache::prepare(const QNetworkCacheMetaData &metaData)
+{
+    if(!is_storable(metaData))
+    {
+        return NULL;
+    }
+
+    QBuffer *buffer = new QBuffer();
+    buffer->open(QIODevice::ReadWrite);
+    inserting.insert(buffer, metaData);
+
+    return buffer;
+}
+
+/**
+ * @brief ResponseCache::insert
+ *      Stores a response that was completely received, evicting the least recently used ones over the size bound.
+ *      It is stored expired, so the next request for it is always sent (conditional) and never served without asking.
+ * @param device
+ *      The device returned by prepare.
+ * @remarks
+ *      This function should be thread-safe.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void ResponseCache::insert(QIODevice *device)
+{
+    QBuffer *buffer = qobject_cast<QBuffer*>(device);
+
+    if(buffer == NULL || !inserting.contains(device))
+    {
+        return;
+    }
+
+    Entry entry;
+    entry.metadata = inserting.take(device);
+    entry.metadata.setExpirationDate(revalidate_date);
+    entry.body = buffer->data();
+    delete buffer;
+
+    QString key = entry_key(entry.metadata.url());
+
+    mutex.lock();
+    erase(key);
+
+    if(entry.body.size() <= maximum_size)
+    {
+        QHash<QString, Entry>::iterator it = entries.insert(key, entry);
+        link(key, *it);
+        size += entry.body.size();
+        evict();
+    }
+    mutex.unlock();
+}
+
+/**
+ * @brief ResponseCache::clear
+ *      Removes all the responses of all the instances and partitions. The counter is kept.
+ * @remarks
+ *      This function should be thread-safe.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void ResponseCache::clear()
+{
+    mutex.lock();
+    entries.clear();
+    newest.clear();
+    oldest.clear();
+    size = 0;
+    mutex.unlock();
+}
+
+/**
+ * @brief ResponseCache::set_maximum_size
+ *      Sets the size bound of the cache, evicting entries if needed.
+ * @param bytes
+ *      Size in bytes, 16MB by default.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void ResponseCache::set_maximum_size(const qint64 &bytes)
+{
+    mutex.lock();
+    maximum_size = bytes;
+    evict();
+    mutex.unlock();
+}
+
+/**
+ * @brief ResponseCache::get_hits
+ *      Number of responses served from memory.
+ * @remarks
+ *      The counter is atomic, it is read without the mutex.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+int ResponseCache::get_hits()
+{
+    return hits.loadAcquire();
+}
+
+/**
+ * @brief ResponseCache::print
+ *      Creates a string with the state of the cache.
+ *      Use and output method that supports HTML.
+ * @return
+ *      Data to be displayed
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+QString ResponseCache::print()
+{
+    mutex.lock();
+    QString cache_print = "Responses: " + QString::number(entries.size()) +
+                          " - Size: " + QString::number(size / 1024) + "KB" +
+                          " - Hits: " + QString::number(hits.loadAcquire());
+    mutex.unlock();
+
+    return cache_print;
+}
+
+/**
+ * @brief ResponseCache::entry_key
+ *      Creates the key of the entry of a URL, in the partition of this instance.
+ * @param url
+ *      URL of the request.
+ * @return
+ *      The key.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+QString ResponseCache::entry_key(const QUrl &url) const
+{
+    return partition + "\n" + url.toString();
+}
+
+/**
+ * @brief ResponseCache::is_storable
+ *      Checks if a response can be stored.
+ *      Qt already decided if it can be saved (e.g. no for "no-store", "Pragma: no-cache" and POST), that is respected.
+ *      A response without ETag or Last-Modified is not stored, since it could never be revalidated.
+ *      "private" responses are stored, the entries of each user are in their own partition.
+ * @param metaData
+ *      Headers of the response.
+ * @return
+ *      True if the response can be stored.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+bool ResponseCache::is_storable(const QNetworkCacheMetaData &metaData)
+{
+    if(!metaData.saveToDisk())
+    {
+        return false;
+    }
+
+    bool etag = false;
+    QNetworkCacheMetaData::RawHeaderList headers = metaData.rawHeaders();
+
+    for(int i = 0; i < headers.size() && !etag; i++)
+    {
+        etag = (headers.at(i).first.toLower() == "etag");
+    }
+
+    return etag || metaData.lastModified().isValid();
+}
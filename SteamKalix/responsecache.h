@@ -0,0 +1,82 @@
+/*
+ * SteamKalix
+ * Copyright (C) 2014 Filipe Carvalho
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef RESPONSECACHE_H
+#define RESPONSECACHE_H
+
+#include <QAbstractNetworkCache>
+#include <QNetworkCacheMetaData>
+#include <QBuffer>
+#include <QMutex>
+#include <QAtomicInt>
+#include <QHash>
+#include <QDateTime>
+
+#include "defines.h"
+
+/**
+ * @brief The ResponseCache class
+ *      In-memory cache of GET responses, shared between all the network managers of the application.
+ *      The validators (ETag and Last-Modified) and the body are stored by URL. The access manager sends
+ *      conditional requests with them and a 304 (Not Modified) is served from memory.
+ * @remarks
+ *      Each access manager needs its own instance (it takes ownership), the entries are shared by all the instances
+ *      of the same partition (the network user), a page of one account is never served to another.
+ *      The cache has a size bound, the least recently used entries are evicted.
+ *      The responses Qt does not save (e.g. "no-store" and POST) are not stored.
+ *      Every stored response is revalidated, a hit is always a conditional request answered by the server.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+class ResponseCache : public QAbstractNetworkCache
+{
+    Q_OBJECT
+
+public_construct:
+    explicit ResponseCache(const QString &partition = QString(), QObject *parent = 0);
+    ~ResponseCache();
+
+public_methods:
+    QNetworkCacheMetaData metaData(const QUrl &url);
+    void updateMetaData(const QNetworkCacheMetaData &metaData);
+    QIODevice* data(const QUrl &url);
+    bool remove(const QUrl &url);
+    qint64 cacheSize() const;
+
+    QIODevice* prepare(const QNetworkCacheMetaData &metaData);
+    void insert(QIODevice *device);
+
+    static void set_maximum_size(const qint64 &bytes);
+    static int get_hits();
+    static QString print();
+
+private_methods:
+    QString entry_key(const QUrl &url) const;
+    static bool is_storable(const QNetworkCacheMetaData &metaData);
+
+private_data_members:
+    QString partition;
+    QHash<QIODevice*, QNetworkCacheMetaData> inserting;
+
+public slots:
+    void clear();
+
+};
+
+#endif // RESPONSECACHE_H
@@ -0,0 +1,144 @@
+/*
+ * SteamKalix
+ * Copyright (C) 2014 Filipe Carvalho
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "sessioncache.h"
+
+/**
+ *@brief Anonymous namespace
+ *      This namespace is used as a "private section".
+ *      It is anonymous and therefore can only accessed within file scope.
+ *@date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+namespace
+{
+    QMutex mutex;
+    QHash<QString, QByteArray> tickets;
+    QAtomicInt hits(0);
+    QAtomicInt misses(0);
+}
+
+/**
+ * @brief SessionCache::get_ticket
+ *      Gets the session ticket of a host and proxy, and counts the hit or miss.
+ * @param key
+ *      The host and proxy.
+ * @return
+ *      The session ticket. Empty if there is no session to resume.
+ * @remarks
+ *      This function should be thread-safe.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+QByteArray SessionCache::get_ticket(const QString &key)
+{
+    mutex.lock();
+    QByteArray ticket = tickets.value(key);
+
+    if(ticket.isEmpty())
+    {
+        misses.ref();
+    }
+    else
+    {
+        hits.ref();
+    }
+    mutex.unlock();
+
+    return ticket;
+}
+
+/**
+ * @brief SessionCache::set_ticket
+ *      Stores the session ticket of a host and proxy, replacing the previous one.
+ * @param key
+ *      The host and proxy.
+ * @param ticket
+ *      The session ticket. Empty tickets are ignored.
+ * @remarks
+ *      This function should be thread-safe.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void SessionCache::set_ticket(const QString &key, const QByteArray &ticket)
+{
+    if(!ticket.isEmpty())
+    {
+        mutex.lock();
+        tickets.insert(key, ticket);
+        mutex.unlock();
+    }
+}
+
+/**
+ * @brief SessionCache::clear
+ *      Removes all the session tickets. The counters are kept.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void SessionCache::clear()
+{
+    mutex.lock();
+    tickets.clear();
+    mutex.unlock();
+}
+
+/**
+ * @brief SessionCache::get_hits
+ * @brief SessionCache::get_misses
+ *      Number of requests that could (hit) or could not (miss) resume a session.
+ * @remarks
+ *      The counters are atomic, they are read without the mutex.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+int SessionCache::get_hits()
+{
+    return hits.loadAcquire();
+}
+
+int SessionCache::get_misses()
+{
+    return misses.loadAcquire();
+}
+
+/**
+ * @brief SessionCache::print
+ *      Creates a string with the state of the cache.
+ *      Use and output method that supports HTML.
+ * @return
+ *      Data to be displayed
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+QString SessionCache::print()
+{
+    mutex.lock();
+    QString cache_print = "TLS sessions: " + QString::number(tickets.size()) +
+                          " - Hits: " + QString::number(hits.loadAcquire()) +
+                          " - Misses: " + QString::number(misses.loadAcquire());
+    mutex.unlock();
+
+    return cache_print;
+}
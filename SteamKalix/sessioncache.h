@@ -0,0 +1,49 @@
+/*
+ * SteamKalix
+ * Copyright (C) 2014 Filipe Carvalho
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SESSIONCACHE_H
+#define SESSIONCACHE_H
+
+#include <QString>
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+#include <QAtomicInt>
+
+/**
+ * @brief The SessionCache namespace
+ *      This namespace is used to share the TLS session tickets between all the network managers of the application.
+ *      A ticket is stored by host and proxy, so a new manager can resume the session instead of doing a full handshake.
+ *      The user is not part of the key, the login and every user on the same proxy share the session.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+namespace SessionCache
+{
+    QByteArray get_ticket(const QString &key);
+    void set_ticket(const QString &key, const QByteArray &ticket);
+    void clear();
+
+    int get_hits();
+    int get_misses();
+
+    QString print();
+}
+
+#endif // SESSIONCACHE_H
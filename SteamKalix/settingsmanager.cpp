@@ -25,9 +25,12 @@
  *@remarks Variables
  *      The variable "filepath" is not immediately initialized because the function "applicationDirPath" makes use of the object
  *      "QApplication", and at this point the object does not yet exist.
+ *      The store has all the keys of the file, it is loaded on first use (store_loaded).
+ *      The changes are written flush_delay milliseconds after the first one, all together (store_dirty).
+ *      The file_mutex keeps two flushes from writing the file at the same time.
  *@date
  *      Created:  Filipe, 9 Mar 2014
- *      Modified: Filipe, 28 May 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
 namespace
 {
@@ -35,6 +38,74 @@ namespace
     QString log_filename = "log.txt";
     QString config_filename = "config.ini";
     QSettings::Format config_fileformat = QSettings::IniFormat;
+
+    const int flush_delay = 1000;
+
+    QReadWriteLock store_lock;
+    QHash<QString, QVariant> store;
+    QAtomicInt store_loaded(0);
+    bool store_dirty = false;
+    QMutex file_mutex;
+    SettingsWriter *settings_writer = NULL;
+
+    /**
+     * @brief load_store
+     *      Parses the file into the store, only the first call reads it.
+     * @date
+     *      Created:  Filipe, 16 Oct 2026
+     *      Modified: Filipe, 16 Oct 2026
+     */
+    void load_store()
+    {
+        if(store_loaded.loadAcquire())
+        {
+            return;
+        }
+
+        store_lock.lockForWrite();
+        if(!store_loaded.load())
+        {
+            QSettings storage(SettingsManager::get_filepath() + config_filename, config_fileformat);
+            QStringList keys = storage.allKeys();
+
+            for(int i = 0; i < keys.size(); i++)
+            {
+                store.insert(keys.at(i), storage.value(keys.at(i)));
+            }
+
+            store_loaded.storeRelease(1);
+        }
+        store_lock.unlock();
+    }
+
+    /**
+     * @brief changed
+     *      Marks the store as changed and schedules the flush, if it is the first change since the last one.
+     * @remarks
+     *      Must be called holding the write lock.
+     *      The writer is created in the thread of the application, the flush runs there.
+     * @date
+     *      Created:  Filipe, 16 Oct 2026
+     *      Modified: Filipe, 16 Oct 2026
+     */
+    void changed()
+    {
+        if(!store_dirty)
+        {
+            store_dirty = true;
+
+            if(settings_writer == NULL && QCoreApplication::instance() != NULL)
+            {
+                settings_writer = new SettingsWriter();
+                settings_writer->moveToThread(QCoreApplication::instance()->thread());
+            }
+
+            if(settings_writer != NULL)
+            {
+                QMetaObject::invokeMethod(settings_writer, "schedule", Qt::QueuedConnection);
+            }
+        }
+    }
 }
 
 /**
@@ -58,24 +129,28 @@ QString SettingsManager::get_filepath()
 
 /**
  * @brief SettingsManager::write
- *      Writes the key and value to the file.
+ *      Writes the key and value to the store, the file is written later (write-behind).
  * @param key
  *      The key.
  * @param value
  *      The value.
  * @date
  *      Created:  Filipe, 9 Mar 2014
- *      Modified: Filipe, 28 May 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
 void SettingsManager::write(const QString &key, const QVariant &value)
 {
-    QSettings storage(get_filepath() + config_filename, config_fileformat);
-    storage.setValue(key, value);
+    load_store();
+
+    store_lock.lockForWrite();
+    store.insert(key, value);
+    changed();
+    store_lock.unlock();
 }
 
 /**
  * @brief SettingsManager::read
- *      Reads a value from a given key.
+ *      Reads a value from a given key, from the store (the file is not read).
  * @param key
  *      The key.
  * @param default_value
@@ -84,27 +159,86 @@ void SettingsManager::write(const QString &key, const QVariant &value)
  *      The value.
  * @date
  *      Created:  Filipe, 9 Mar 2014
- *      Modified: Filipe, 28 May 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
 QVariant SettingsManager::read(const QString &key, const QVariant &default_value)
 {
-    QSettings storage(get_filepath() + config_filename, config_fileformat);
-    return storage.value(key, default_value);
+    load_store();
+
+    store_lock.lockForRead();
+    QVariant value = store.value(key, default_value);
+    store_lock.unlock();
+
+    return value;
 }
 
 /**
  * @brief SettingsManager::remove
  *      Removes the setting key and any sub-settings of key.
  * @param key
- *      The key.
+ *      The key. An empty key removes all the settings, as QSettings does.
  * @date
  *      Created:  Filipe, 5 Jun 2014
- *      Modified: Filipe, 5 Jun 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
 void SettingsManager::remove(const QString &key)
 {
-    QSettings storage(get_filepath() + config_filename, config_fileformat);
-    return storage.remove(key);
+    load_store();
+
+    QString group = key + "/";
+
+    store_lock.lockForWrite();
+    QHash<QString, QVariant>::iterator i = store.begin();
+    while(i != store.end())
+    {
+        if(key.isEmpty() || i.key() == key || i.key().startsWith(group))
+        {
+            i = store.erase(i);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    changed();
+    store_lock.unlock();
+}
+
+/**
+ * @brief SettingsManager::flush
+ *      Writes the store to the file, if it changed. All the keys are written with one QSettings and one sync.
+ * @remarks
+ *      The store is copied (implicitly shared), the reads and writes do not wait for the file.
+ *      Called by the SettingsWriter and on shutdown (SteamKalix::save_settings).
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void SettingsManager::flush()
+{
+    file_mutex.lock();
+
+    store_lock.lockForWrite();
+    bool dirty = store_dirty;
+    QHash<QString, QVariant> snapshot = store;
+    store_dirty = false;
+    store_lock.unlock();
+
+    if(dirty)
+    {
+        QSettings storage(get_filepath() + config_filename, config_fileformat);
+        storage.clear();
+
+        for(QHash<QString, QVariant>::const_iterator i = snapshot.constBegin(); i != snapshot.constEnd(); ++i)
+        {
+            storage.setValue(i.key(), i.value());
+        }
+
+        storage.sync();
+    }
+
+    file_mutex.unlock();
 }
 
 /**
@@ -129,3 +263,45 @@ void SettingsManager::log(QString message)
         stream << message << endl;
     }
 }
+
+/**
+ * @brief SettingsWriter::SettingsWriter
+ *      Initializes the flush timer.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+SettingsWriter::SettingsWriter(QObject *parent) :
+    QObject(parent),
+    flush_timer(new QTimer(this))
+{
+    flush_timer->setSingleShot(true);
+    connect(flush_timer, SIGNAL(timeout()), this, SLOT(flush()));
+}
+
+/**
+ * @brief SettingsWriter::schedule
+ *      Starts the flush timer, the changes that follow are written with the first one.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void SettingsWriter::schedule()
+{
+    if(!flush_timer->isActive())
+    {
+        flush_timer->start(flush_delay);
+    }
+}
+
+/**
+ * @brief SettingsWriter::flush
+ *      Writes the changes to the file, see SettingsManager::flush.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void SettingsWriter::flush()
+{
+    SettingsManager::flush();
+}
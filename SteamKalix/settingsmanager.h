@@ -24,13 +24,26 @@
 #include <QFile>
 #include <QTextStream>
 #include <QDateTime>
+#include <QReadWriteLock>
+#include <QAtomicInt>
+#include <QStringList>
+#include <QObject>
+#include <QTimer>
+#include <QMutex>
+#include <QHash>
+
+#include "defines.h"
 
 /**
  * @brief The SettingsManager namespace
  *      This namespace is used implement static functions to intetact with the configuration file directly.
+ * @remarks
+ *      The file is parsed once, on first use, into a store kept in memory behind a reader-writer lock.
+ *      The reads only use the store. The writes change the store and are written to the file together,
+ *      by the SettingsWriter one second after the first change, or by flush.
  * @date
  *      Created:  Filipe, 9 Mar 2014
- *      Modified: Filipe, 9 Mar 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
 namespace SettingsManager
 {
@@ -39,8 +52,35 @@ namespace SettingsManager
     void write(const QString &key, const QVariant &value);
     QVariant read(const QString &key, const QVariant &default_value = QVariant());
     void remove(const QString &key);
+    void flush();
 
     void log(QString message);
 }
 
+/**
+ * @brief The SettingsWriter class
+ *      Runs the write-behind timer of the SettingsManager, in the thread of the application.
+ *      This class is private to the SettingsManager.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+class SettingsWriter : public QObject
+{
+    Q_OBJECT
+
+public_construct:
+    explicit SettingsWriter(QObject *parent = 0);
+
+private_data_members:
+    QTimer *flush_timer;
+
+public slots:
+    void schedule();
+
+private slots:
+    void flush();
+
+};
+
 #endif // SETTINGSMANAGER_H
@@ -170,7 +170,7 @@ void SteamKalix::load_connections()
  *      Loads UI settings.
  * @date
  *      Created:  Filipe, 9 Mar 2014
- *      Modified: Filipe, 3 Sep 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
 void SteamKalix::load_settings()
 {
@@ -249,6 +249,9 @@ void SteamKalix::load_settings()
     ui->cb_logging->setChecked(SettingsManager::read("OptionsTab/Log", false).toBool());
     Output::set_logging(SettingsManager::read("OptionsTab/Log", false).toBool());
 
+    //No UI option, the interval (ms) of the background cookie saves, 0 disables them.
+    PersistentCookieJar::set_flush_interval(SettingsManager::read("OptionsTab/CookieFlush", 5000).toInt());
+
     int verbose = SettingsManager::read("OptionsTab/Verbose", 2).toInt();
     if(verbose <= 1)
     {
@@ -269,10 +272,10 @@ void SteamKalix::load_settings()
 
 /**
  * @brief SteamKalix::save_settings
- *      Saves UI settings.
+ *      Saves UI settings and writes them to the file (SettingsManager::flush).
  * @date
  *      Created:  Filipe, 9 Mar 2014
- *      Modified: Filipe, 3 Sep 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
 void SteamKalix::save_settings()
 {
@@ -353,6 +356,10 @@ void SteamKalix::save_settings()
     SettingsManager::write("OptionsTab/Verbose", ui->rb_log_essencial->isChecked() ? 1 :
                                                  ui->rb_log_normal->isChecked() ? 2 :
                                                  ui->rb_log_debug->isChecked() ? 3 : 2);
+    SettingsManager::write("OptionsTab/CookieFlush", PersistentCookieJar::get_flush_interval());
+
+    //The settings above are written to the file at once
+    SettingsManager::flush();
 }
 
 /*************************************************************************************/
@@ -1194,7 +1201,7 @@ void SteamKalix::on_btn_pause_clicked()
  *      Index of the clicked items.
  * @date
  *      Created:  Filipe, 5 Apr 2014
- *      Modified: Filipe, 5 Apr 2014
+ *      Modified: Filipe, 16 Oct 2026
  */
 void SteamKalix::on_table_listings_clicked(const QModelIndex &index)
 {
@@ -1208,7 +1215,14 @@ void SteamKalix::on_table_listings_clicked(const QModelIndex &index)
 
     ui->sb_connections->setValue(index.sibling(row, 6).data().toInt());
     ui->sb_refresh->setValue(index.sibling(row, 7).data().toInt());
-    ui->sb_timeout->setValue(index.sibling(row, 8).data().toInt());
+    if(index.sibling(row, 8).data().toString() == ui->sb_timeout->specialValueText())
+    {
+        ui->sb_timeout->setValue(NetworkManager::timeout_auto);
+    }
+    else
+    {
+        ui->sb_timeout->setValue(index.sibling(row, 8).data().toInt());
+    }
     ui->sb_delay->setValue(index.sibling(row, 9).data().toInt());
     ui->cb_delay_random->setChecked(index.sibling(row, 10).data().toBool());
 
@@ -0,0 +1,255 @@
+/*
+ * SteamKalix
+ * Copyright (C) 2014 Filipe Carvalho
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "streamdecoder.h"
+
+/**
+ *@brief Anonymous namespace
+ *      This namespace is used as a "private section".
+ *      It is anonymous and therefore can only accessed within file scope.
+ *@remarks Variables
+ *      The output grows by at least chunk_minimum, or 4 times the input (JSON compresses well).
+ *@date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+namespace
+{
+    const int chunk_minimum = 16 * 1024;
+}
+
+/**
+ * @brief StreamDecoder::StreamDecoder
+ *      Initializes the decoder of an encoding.
+ * @param encoding
+ *      The Content-Encoding of the reply. gzip and deflate share the zlib decoder, the header is detected.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+StreamDecoder::StreamDecoder(const QByteArray &encoding) :
+    decoder(decoder_zlib),
+    state_error(false),
+    state_finished(false),
+    state_started(true)
+{
+    zlib_stream.zalloc = Z_NULL;
+    zlib_stream.zfree = Z_NULL;
+    zlib_stream.opaque = Z_NULL;
+    zlib_stream.next_in = Z_NULL;
+    zlib_stream.avail_in = 0;
+
+#ifdef HAVE_BROTLI
+    brotli_state = NULL;
+
+    if(encoding.trimmed().toLower() == "br")
+    {
+        decoder = decoder_brotli;
+        brotli_state = BrotliDecoderCreateInstance(NULL, NULL, NULL);
+        state_error = (brotli_state == NULL);
+        return;
+    }
+#else
+    Q_UNUSED(encoding);
+#endif
+
+    //zlib is initialized on the first 2 bytes, see decode
+    state_started = false;
+}
+
+/**
+ * @brief StreamDecoder::~StreamDecoder
+ *      Frees the state of the decoder.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+StreamDecoder::~StreamDecoder()
+{
+#ifdef HAVE_BROTLI
+    if(brotli_state != NULL)
+    {
+        BrotliDecoderDestroyInstance(brotli_state);
+        return;
+    }
+#endif
+
+    if(state_started)
+    {
+        inflateEnd(&zlib_stream);
+    }
+}
+
+/**
+ * @brief StreamDecoder::decode
+ *      Decodes a chunk of the body and appends the result to the output.
+ * @param data
+ *      The chunk, as received.
+ * @param output
+ *      The decoded data is appended here.
+ * @return
+ *      False if the body is corrupted, the following chunks are ignored.
+ * @remarks
+ *      Some servers send "deflate" without the zlib header. The header is verified on the first 2 bytes,
+ *      without it the body is decoded as raw deflate.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+bool StreamDecoder::decode(const QByteArray &data, QByteArray &output)
+{
+    if(state_error || state_finished || data.isEmpty())
+    {
+        return !state_error;
+    }
+
+    int chunk = qMax(chunk_minimum, data.size() * 4);
+
+#ifdef HAVE_BROTLI
+    if(decoder == decoder_brotli)
+    {
+        size_t available_in = data.size();
+        const uint8_t *next_in = reinterpret_cast<const uint8_t*>(data.constData());
+        BrotliDecoderResult result;
+
+        do
+        {
+            int size = output.size();
+            output.resize(size + chunk);
+
+            size_t available_out = chunk;
+            uint8_t *next_out = reinterpret_cast<uint8_t*>(output.data() + size);
+            result = BrotliDecoderDecompressStream(brotli_state, &available_in, &next_in, &available_out, &next_out, NULL);
+
+            output.resize(size + chunk - static_cast<int>(available_out));
+        }
+        while(result == BROTLI_DECODER_RESULT_NEEDS_MORE_OUTPUT);
+
+        state_error = (result == BROTLI_DECODER_RESULT_ERROR);
+        state_finished = (result == BROTLI_DECODER_RESULT_SUCCESS);
+
+        return !state_error;
+    }
+#endif
+
+    if(!state_started)
+    {
+        //gzip (1F 8B) or zlib (CM 8 and check bits) header, otherwise raw deflate
+        header.append(data);
+
+        if(header.size() < 2)
+        {
+            return true;
+        }
+
+        uchar byte1 = static_cast<uchar>(header.at(0));
+        uchar byte2 = static_cast<uchar>(header.at(1));
+        bool wrapped = (byte1 == 0x1f && byte2 == 0x8b) || ((byte1 & 0x0f) == 8 && (byte1 * 256 + byte2) % 31 == 0);
+
+        state_started = true;
+        state_error = (inflateInit2(&zlib_stream, wrapped ? 15 + 32 : -15) != Z_OK);
+
+        QByteArray first_data = header;
+        header.clear();
+
+        return !state_error && decode(first_data, output);
+    }
+
+    zlib_stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.constData()));
+    zlib_stream.avail_in = data.size();
+
+    do
+    {
+        int size = output.size();
+        output.resize(size + chunk);
+
+        zlib_stream.next_out = reinterpret_cast<Bytef*>(output.data() + size);
+        zlib_stream.avail_out = chunk;
+        int result = inflate(&zlib_stream, Z_NO_FLUSH);
+
+        output.resize(size + chunk - static_cast<int>(zlib_stream.avail_out));
+
+        if(result == Z_STREAM_END)
+        {
+            state_finished = true;
+            break;
+        }
+
+        if(result != Z_OK && result != Z_BUF_ERROR)
+        {
+            state_error = true;
+            break;
+        }
+    }
+    while(zlib_stream.avail_in > 0 || zlib_stream.avail_out == 0);
+
+    return !state_error;
+}
+
+/**
+ * @brief StreamDecoder::has_error
+ *      True if the body could not be decoded.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+bool StreamDecoder::has_error() const
+{
+    return state_error;
+}
+
+/**
+ * @brief StreamDecoder::is_supported
+ *      Verifies if a Content-Encoding can be decoded.
+ * @param encoding
+ *      The Content-Encoding of the reply.
+ * @return
+ *      True for gzip, deflate (and br with brotli). Identity and empty are not decoded.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+bool StreamDecoder::is_supported(const QByteArray &encoding)
+{
+    QByteArray content_encoding = encoding.trimmed().toLower();
+
+#ifdef HAVE_BROTLI
+    if(content_encoding == "br")
+    {
+        return true;
+    }
+#endif
+
+    return content_encoding == "gzip" || content_encoding == "x-gzip" || content_encoding == "deflate";
+}
+
+/**
+ * @brief StreamDecoder::accept_encoding
+ *      The value of the Accept-Encoding header, the encodings this decoder supports by preference.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+QByteArray StreamDecoder::accept_encoding()
+{
+#ifdef HAVE_BROTLI
+    return "br, gzip, deflate";
+#else
+    return "gzip, deflate";
+#endif
+}
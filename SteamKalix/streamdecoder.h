@@ -0,0 +1,82 @@
+/*
+ * SteamKalix
+ * Copyright (C) 2014 Filipe Carvalho
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef STREAMDECODER_H
+#define STREAMDECODER_H
+
+#include <QByteArray>
+#include <zlib.h>
+
+#ifdef HAVE_BROTLI
+#include <brotli/decode.h>
+#endif
+
+#include "defines.h"
+
+/**
+ * @brief The StreamDecoder class
+ *      Decompresses a body while it arrives (Content-Encoding gzip, deflate and br), chunk by chunk.
+ *      The access manager only decompresses the encodings it asked for itself, since the requests
+ *      set Accept-Encoding explicitly the bodies are decoded here, before they reach the buffer or the JSON stream.
+ * @remarks
+ *      Brotli is only supported when built with HAVE_BROTLI (libbrotlidec found by pkg-config).
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+class StreamDecoder
+{
+
+public_construct:
+    explicit StreamDecoder(const QByteArray &encoding);
+    ~StreamDecoder();
+
+public_methods:
+    bool decode(const QByteArray &data, QByteArray &output);
+    bool has_error() const;
+
+    static bool is_supported(const QByteArray &encoding);
+    static QByteArray accept_encoding();
+
+private_methods:
+    Q_DISABLE_COPY(StreamDecoder)
+
+public_enums:
+    enum decoders
+    {
+        decoder_zlib = 0,
+        decoder_brotli = 1
+    };
+
+private_members:
+    int decoder;
+    bool state_error;
+    bool state_finished;
+    bool state_started;
+
+private_data_members:
+    z_stream zlib_stream;
+    QByteArray header;
+
+#ifdef HAVE_BROTLI
+    BrotliDecoderState *brotli_state;
+#endif
+
+};
+
+#endif // STREAMDECODER_H
@@ -0,0 +1,228 @@
+/*
+ * SteamKalix
+ * Copyright (C) 2014 Filipe Carvalho
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "timerwheel.h"
+
+/**
+ *@brief Anonymous namespace
+ *      This namespace is used as a "private section".
+ *      It is anonymous and therefore can only accessed within file scope.
+ *@remarks Variables
+ *      The first level has 256 slots (one per tick), the second level 64 slots (one per turn of the first).
+ *      With the default resolution of 10ms, this covers about 163 seconds. Longer deadlines wait in the
+ *      last slot of the second level and are scheduled again when it expires.
+ *@date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+namespace
+{
+    const int ticks_bits = 8;
+    const int ticks_size = 1 << ticks_bits;
+    const int turns_size = 64;
+}
+
+/**
+ * @brief TimerWheel::TimerWheel
+ *      Initializes the wheel and the timer.
+ * @param resolution
+ *      Duration of a tick, in milliseconds. Deadlines are rounded up to the next tick.
+ * @param parent
+ *      The network manager.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+TimerWheel::TimerWheel(const int &resolution, QObject *parent) :
+    QObject(parent),
+    resolution(resolution > 0 ? resolution : 1),
+    ticks(0),
+    deadlines(0),
+    expired(0),
+    timer(new QTimer(this)),
+    wheel_ticks(ticks_size),
+    wheel_turns(turns_size)
+{
+    clock.start();
+    timer->setInterval(this->resolution);
+    connect(timer, SIGNAL(timeout()), this, SLOT(tick()));
+}
+
+/**
+ * @brief TimerWheel::add
+ *      Adds the deadline of a request to the wheel.
+ * @param reply
+ *      The reply of the request. It is closed if it is still running at the deadline.
+ * @param timeout
+ *      Amount of time until the request timeouts, in milliseconds.
+ * @remarks
+ *      The deadline is counted from the clock, not from the last tick, so a late event loop does not expire it early.
+ *      It is always after the current tick of the wheel, the slots up to it were already expired.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void TimerWheel::add(QNetworkReply *reply, const int &timeout)
+{
+    if(deadlines == 0)
+    {
+        //The wheel is empty, move it to the current time without going through the slots.
+        ticks = clock.elapsed() / resolution;
+        timer->start();
+    }
+
+    //The deadline follows the clock, the wheel may be behind it when the event loop is late
+    qint64 now = clock.elapsed();
+
+    Deadline deadline;
+    deadline.reply = reply;
+    deadline.tick = qMax(ticks + 1, (now + timeout + resolution - 1) / resolution);
+
+    schedule(deadline);
+    deadlines++;
+}
+
+/**
+ * @brief TimerWheel::schedule
+ *      Places a deadline in the slot of its tick (same turn) or of its turn.
+ * @param deadline
+ *      The deadline, it must be after the current tick.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void TimerWheel::schedule(const Deadline &deadline)
+{
+    qint64 turn = ticks >> ticks_bits;
+    qint64 deadline_turn = deadline.tick >> ticks_bits;
+
+    if(deadline_turn == turn)
+    {
+        wheel_ticks[deadline.tick & (ticks_size - 1)].append(deadline);
+    }
+    else if(deadline_turn - turn < turns_size)
+    {
+        wheel_turns[deadline_turn % turns_size].append(deadline);
+    }
+    else
+    {
+        wheel_turns[(turn + turns_size - 1) % turns_size].append(deadline);
+    }
+}
+
+/**
+ * @brief TimerWheel::tick
+ *      This slot is received from the timeout() signal of the timer.
+ *      Advances the wheel up to the current time. When the first level completes a turn,
+ *      the next slot of the second level is spread over the first level.
+ * @remarks
+ *      The wheel follows the clock, so a late timer expires all the late ticks at once.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void TimerWheel::tick()
+{
+    qint64 now = clock.elapsed() / resolution;
+    int expired_tick = expired;
+
+    while(ticks < now && deadlines > 0)
+    {
+        ticks++;
+        int index = ticks & (ticks_size - 1);
+
+        if(index == 0)
+        {
+            QVector<Deadline> turn_slot;
+            turn_slot.swap(wheel_turns[(ticks >> ticks_bits) % turns_size]);
+
+            for(int i = 0; i < turn_slot.size(); i++)
+            {
+                schedule(turn_slot.at(i));
+            }
+        }
+
+        if(!wheel_ticks.at(index).isEmpty())
+        {
+            QVector<Deadline> tick_slot;
+            tick_slot.swap(wheel_ticks[index]);
+            expire(tick_slot);
+        }
+    }
+
+    if(deadlines == 0)
+    {
+        timer->stop();
+    }
+
+    if(expired > expired_tick)
+    {
+        emit timeouts(expired - expired_tick);
+    }
+}
+
+/**
+ * @brief TimerWheel::expire
+ *      Closes all the requests of a slot that are still running.
+ *      The closed replies are marked with the "timed_out" property, so their latency is still a sample of the route.
+ * @param slot
+ *      The deadlines of the current tick.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+void TimerWheel::expire(const QVector<Deadline> &slot)
+{
+    for(int i = 0; i < slot.size(); i++)
+    {
+        QNetworkReply *reply = slot.at(i).reply.data();
+
+        if(reply != NULL && reply->isRunning())
+        {
+            reply->setProperty("timed_out", true);
+            reply->close();
+            expired++;
+        }
+    }
+
+    deadlines -= slot.size();
+}
+
+/**
+ * @brief TimerWheel::pending
+ *      Number of deadlines in the wheel, including the ones of requests that already finished.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+int TimerWheel::pending() const
+{
+    return deadlines;
+}
+
+/**
+ * @brief TimerWheel::timed_out
+ *      Number of requests that were closed by the wheel.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+int TimerWheel::timed_out() const
+{
+    return expired;
+}
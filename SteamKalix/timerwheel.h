@@ -0,0 +1,88 @@
+/*
+ * SteamKalix
+ * Copyright (C) 2014 Filipe Carvalho
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+#include <QObject>
+#include <QNetworkReply>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QVector>
+#include <QTimer>
+
+#include "defines.h"
+
+/**
+ * @brief The TimerWheel class
+ *      This class implements the timeout system of the network manager, replacing one timer per request.
+ *      All the deadlines are kept in a hierarchical timer wheel: the first level has one slot per tick,
+ *      the second level has one slot per turn of the first. Adding a deadline is O(1) and a single
+ *      timer expires every deadline of a slot in batch.
+ * @remarks
+ *      The timer only runs while there are deadlines in the wheel.
+ *      Requests that finish before the deadline are skipped when their slot expires.
+ * @date
+ *      Created:  Filipe, 16 Oct 2026
+ *      Modified: Filipe, 16 Oct 2026
+ */
+class TimerWheel : public QObject
+{
+    Q_OBJECT
+
+public_construct:
+    explicit TimerWheel(const int &resolution = 10, QObject *parent = 0);
+
+public_methods:
+    void add(QNetworkReply *reply, const int &timeout);
+
+    int pending() const;
+    int timed_out() const;
+
+private_methods:
+    struct Deadline;
+    void schedule(const Deadline &deadline);
+    void expire(const QVector<Deadline> &slot);
+
+private_members:
+    int resolution;
+    qint64 ticks;
+    int deadlines;
+    int expired;
+
+private_data_members:
+    struct Deadline
+    {
+        QPointer<QNetworkReply> reply;
+        qint64 tick;
+    };
+
+    QTimer *timer;
+    QElapsedTimer clock;
+    QVector<QVector<Deadline> > wheel_ticks;
+    QVector<QVector<Deadline> > wheel_turns;
+
+private slots:
+    void tick();
+
+signals:
+    void timeouts(const int &count);
+
+};
+
+#endif // TIMERWHEEL_H
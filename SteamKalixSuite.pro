@@ -0,0 +1,10 @@
+#-------------------------------------------------
+#
+# SteamKalix and the mock servers used to test it offline.
+#
+#-------------------------------------------------
+
+TEMPLATE = subdirs
+
+SUBDIRS = SteamKalix \
+          MockMarket